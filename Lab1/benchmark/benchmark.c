@@ -0,0 +1,513 @@
+/**
+ * @file benchmark.c
+ * @brief Banco de pruebas de rendimiento de los motores de búsqueda.
+ *
+ * Cuenta las permutaciones gráciles de N = 8..15 con cada variante del
+ * motor, verifica el conteo contra los valores conocidos y mide el tiempo
+ * con corridas de calentamiento y varias repeticiones. Las búsquedas muy
+ * cortas se repiten dentro de cada medición hasta durar al menos
+ * TIEMPO_MINIMO_MEDICION para que la resolución del reloj no domine. Los
+ * resultados se muestran en una tabla y se pueden exportar en JSON o CSV.
+ *
+ * Para que el motor original no tome horas, un caso deja de repetirse al
+ * pasar TIEMPO_MAXIMO_CASO y una variante cuya búsqueda tarda más de
+ * `--limite` segundos no se mide con N mayores.
+ *
+ * Uso: benchmark [--desde N] [--hasta N] [--repeticiones R]
+ *                [--calentamiento W] [--threads K] [--variantes a,b,...]
+ *                [--limite S] [--json ARCH] [--csv ARCH]
+ *
+ * Termina con código 1 si algún conteo no coincide con el conocido.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "busqueda.h"
+#include "cancelacion.h"
+#include "hilos.h"
+#include "hojas.h"
+#include "punto_control.h"
+
+#define N_BENCHMARK_MAXIMO 16         ///< Mayor N con conteo conocido en la tabla.
+#define MAX_REPETICIONES 100          ///< Máximo de repeticiones medidas por caso.
+#define TIEMPO_MINIMO_MEDICION 0.05   ///< Segundos mínimos de cada medición.
+#define TIEMPO_CALENTAMIENTO_LARGO 1.0 ///< Una corrida así de larga basta como calentamiento.
+#define TIEMPO_MAXIMO_CASO 30.0       ///< Tras estos segundos midiendo un caso no se repite más.
+
+/** @brief Permutaciones gráciles conocidas (OEIS A006967) para N = 0..16. */
+static const unsigned long conteosConocidos[N_BENCHMARK_MAXIMO + 1] = {
+    0, 1, 2, 4, 4, 8, 24, 32, 40, 120, 296, 648, 1328, 3200, 9912, 25592, 55920
+};
+
+/**
+ * @brief Resultado de una búsqueda completa.
+ */
+typedef struct {
+    unsigned long permutaciones; ///< Permutaciones gráciles contadas.
+    unsigned long nodos;         ///< Nodos visitados (0 si el motor no los cuenta).
+} corrida_t;
+
+/**
+ * @brief Una variante del motor que se puede medir.
+ */
+typedef struct {
+    const char *nombre;      ///< Nombre para --variantes y para los resultados.
+    const char *descripcion; ///< Descripción corta para la ayuda.
+    int (*ejecutar)(int N, int hilos, corrida_t *c); ///< Cuenta el árbol de N; 0 si pudo.
+} variante_t;
+
+/**
+ * @brief Estadísticas de las repeticiones de un caso (variante y N).
+ */
+typedef struct {
+    const variante_t *variante; ///< Variante medida.
+    int N;                      ///< Tamaño del conjunto de números.
+    corrida_t corrida;          ///< Conteo de la última corrida.
+    int correcto;               ///< 1 si el conteo coincide con el conocido.
+    int vueltas;                ///< Búsquedas completas dentro de cada medición.
+    int repeticiones;           ///< Mediciones hechas (menos que las pedidas si el caso es largo).
+    double minimo;              ///< Menor tiempo por búsqueda (segundos).
+    double mediana;             ///< Mediana del tiempo por búsqueda.
+    double media;               ///< Media del tiempo por búsqueda.
+    double desviacion;          ///< Desviación estándar muestral del tiempo por búsqueda.
+} caso_t;
+
+/** @brief Plazo que nunca vence: el banco siempre termina las búsquedas. */
+static cancelacion_t sinPlazo;
+
+/**
+ * @brief Llena los parámetros comunes de las variantes del motor con máscaras.
+ */
+static void prepararParametros(parametrosBusqueda_t *parametros, int N) {
+    memset(parametros, 0, sizeof(*parametros));
+    parametros->N = N;
+    parametros->cancelacion = &sinPlazo;
+}
+
+static int ejecutarOriginal(int N, int hilos, corrida_t *c) {
+    (void)hilos;
+    int arregloNumeros[N];
+    int numerosUsados[N + 1];
+    int diferenciasUsadas[N];
+    memset(numerosUsados, 0, sizeof(numerosUsados));
+    memset(diferenciasUsadas, 0, sizeof(diferenciasUsadas));
+    c->permutaciones = 0;
+    c->nodos = 0;  // El motor original no cuenta nodos
+    encontrarPermutaciones(0, N, arregloNumeros, numerosUsados, diferenciasUsadas,
+                           &c->permutaciones, clock(), 1 << 20);
+    return 0;
+}
+
+static int ejecutarBits(int N, int hilos, corrida_t *c) {
+    (void)hilos;
+    parametrosBusqueda_t parametros;
+    busquedaBits_t b;
+    prepararParametros(&parametros, N);
+    iniciarBusquedaBits(&b, &parametros);
+    encontrarPermutacionesBits(&b, 0);
+    c->permutaciones = b.totalPermutaciones;
+    c->nodos = b.nodos;
+    return 0;
+}
+
+/**
+ * @brief Motor iterativo secuencial, igual que main() sin --threads.
+ */
+static int ejecutarIterativoCon(const parametrosBusqueda_t *parametros, corrida_t *c) {
+    busquedaBits_t b;
+    iniciarBusquedaBits(&b, parametros);
+    b.nodos++;  // La raiz
+    iniciarTarea(&b, 0, candidatosBits(&b, 0), 1.0);
+    completarTarea(&b);
+    c->permutaciones = b.totalPermutaciones;
+    c->nodos = b.nodos;
+    return 0;
+}
+
+static int ejecutarIterativo(int N, int hilos, corrida_t *c) {
+    (void)hilos;
+    parametrosBusqueda_t parametros;
+    prepararParametros(&parametros, N);
+    return ejecutarIterativoCon(&parametros, c);
+}
+
+static int ejecutarGenerico(int N, int hilos, corrida_t *c) {
+    (void)hilos;
+    parametrosBusqueda_t parametros;
+    prepararParametros(&parametros, N);
+    parametros.nucleoGenerico = 1;
+    return ejecutarIterativoCon(&parametros, c);
+}
+
+static int ejecutarEscalar(int N, int hilos, corrida_t *c) {
+    (void)hilos;
+    parametrosBusqueda_t parametros;
+    prepararParametros(&parametros, N);
+    parametros.sinSimd = 1;
+    return ejecutarIterativoCon(&parametros, c);
+}
+
+static int ejecutarSinPropagacion(int N, int hilos, corrida_t *c) {
+    (void)hilos;
+    parametrosBusqueda_t parametros;
+    prepararParametros(&parametros, N);
+    parametros.sinPropagacion = 1;
+    return ejecutarIterativoCon(&parametros, c);
+}
+
+static int ejecutarSimetria(int N, int hilos, corrida_t *c) {
+    (void)hilos;
+    parametrosBusqueda_t parametros;
+    prepararParametros(&parametros, N);
+    parametros.simetria = 1;
+    return ejecutarIterativoCon(&parametros, c);
+}
+
+/**
+ * @brief Búsqueda en paralelo con robo de trabajo o prefijos fijos.
+ */
+static int ejecutarParaleloCon(int N, int hilos, int robar, corrida_t *c) {
+    parametrosBusqueda_t parametros;
+    configEjecutor_t config;
+    resultadoBusqueda_t resultado;
+    prepararParametros(&parametros, N);
+    config.hilos = hilos;
+    config.robar = robar;
+    config.archivoPuntoControl = NULL;
+    config.intervaloPuntoControl = INTERVALO_PUNTO_CONTROL;
+    config.fragmento = 0;
+    config.fragmentos = 1;
+    config.intervaloProgreso = 0;
+    config.progresoJson = 0;
+    if (buscarEnParalelo(&parametros, &config, &resultado, NULL) != 0) {
+        return -1;
+    }
+    c->permutaciones = resultado.totalPermutaciones;
+    c->nodos = resultado.nodos;
+    return 0;
+}
+
+static int ejecutarHilos(int N, int hilos, corrida_t *c) {
+    return ejecutarParaleloCon(N, hilos, 1, c);
+}
+
+static int ejecutarEstatico(int N, int hilos, corrida_t *c) {
+    return ejecutarParaleloCon(N, hilos, 0, c);
+}
+
+/** @brief Variantes en el orden en que se miden. */
+static const variante_t variantes[] = {
+    {"original", "motor recursivo original con arreglos", ejecutarOriginal},
+    {"bits", "motor recursivo con mascaras de bits", ejecutarBits},
+    {"iterativo", "motor iterativo con nucleo especializado para N", ejecutarIterativo},
+    {"generico", "motor iterativo con nucleo generico", ejecutarGenerico},
+    {"escalar", "motor iterativo sin AVX2/AVX-512 en las hojas", ejecutarEscalar},
+    {"sin-propagacion", "motor iterativo sin poda por diferencias grandes", ejecutarSinPropagacion},
+    {"simetria", "motor iterativo con reduccion por simetria", ejecutarSimetria},
+    {"hilos", "K hilos con robo de trabajo", ejecutarHilos},
+    {"estatico", "K hilos con prefijos fijos", ejecutarEstatico},
+};
+#define NUM_VARIANTES ((int)(sizeof(variantes) / sizeof(variantes[0])))
+
+static void mostrarUso(const char *programa) {
+    printf("Uso: %s [opciones]\n", programa);
+    printf("Opciones:\n");
+    printf("  --desde N          Menor N medido (por defecto 8)\n");
+    printf("  --hasta N          Mayor N medido (por defecto 15, maximo %d)\n", N_BENCHMARK_MAXIMO);
+    printf("  --repeticiones R   Mediciones por caso (por defecto 5)\n");
+    printf("  --calentamiento W  Corridas sin medir antes de cada caso (por defecto 1)\n");
+    printf("  --threads K        Hilos de las variantes paralelas (por defecto, los nucleos)\n");
+    printf("  --variantes LISTA  Variantes separadas por comas (por defecto, todas)\n");
+    printf("  --limite S         No mide N mayores si una busqueda tarda mas de S segundos (por defecto 60)\n");
+    printf("  --json ARCH        Exporta los resultados en JSON\n");
+    printf("  --csv ARCH         Exporta los resultados en CSV\n");
+    printf("Variantes:\n");
+    for (int i = 0; i < NUM_VARIANTES; i++) {
+        printf("  %-16s %s\n", variantes[i].nombre, variantes[i].descripcion);
+    }
+}
+
+/**
+ * @brief Marca las variantes de una lista separada por comas.
+ *
+ * @return int 0 si todos los nombres existen, -1 si no.
+ */
+static int elegirVariantes(const char *lista, int elegidas[]) {
+    memset(elegidas, 0, NUM_VARIANTES * sizeof(int));
+    const char *inicio = lista;
+    while (*inicio != '\0') {
+        size_t largo = strcspn(inicio, ",");
+        int encontrada = 0;
+        for (int i = 0; i < NUM_VARIANTES; i++) {
+            if (strlen(variantes[i].nombre) == largo && strncmp(variantes[i].nombre, inicio, largo) == 0) {
+                elegidas[i] = 1;
+                encontrada = 1;
+            }
+        }
+        if (!encontrada) {
+            printf("Variante desconocida: %.*s\n", (int)largo, inicio);
+            return -1;
+        }
+        inicio += largo;
+        if (*inicio == ',') {
+            inicio++;
+        }
+    }
+    return 0;
+}
+
+static int compararDoubles(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Mide una variante para un N: calentamiento, calibración de vueltas y repeticiones.
+ *
+ * @return int 0 si todas las búsquedas se pudieron ejecutar.
+ */
+static int medirCaso(caso_t *caso, int repeticiones, int calentamiento, int hilos) {
+    const variante_t *v = caso->variante;
+    double tiempos[MAX_REPETICIONES];
+
+    // Calentamiento; tambien fija cuantas vueltas caben en TIEMPO_MINIMO_MEDICION
+    double porVuelta = 0;
+    for (int i = 0; i < calentamiento || porVuelta == 0; i++) {
+        double inicio = relojMonotonico();
+        if (v->ejecutar(caso->N, hilos, &caso->corrida) != 0) {
+            return -1;
+        }
+        porVuelta = relojMonotonico() - inicio;
+        if (porVuelta >= TIEMPO_CALENTAMIENTO_LARGO) {
+            break;  // Una busqueda larga ya calento caches y frecuencia
+        }
+        if (porVuelta <= 0) {
+            porVuelta = 1e-9;
+        }
+    }
+    caso->vueltas = porVuelta >= TIEMPO_MINIMO_MEDICION ? 1 : (int)ceil(TIEMPO_MINIMO_MEDICION / porVuelta);
+
+    double inicioCaso = relojMonotonico();
+    caso->repeticiones = 0;
+    while (caso->repeticiones < repeticiones &&
+           (caso->repeticiones == 0 || relojMonotonico() - inicioCaso < TIEMPO_MAXIMO_CASO)) {
+        double inicio = relojMonotonico();
+        for (int k = 0; k < caso->vueltas; k++) {
+            if (v->ejecutar(caso->N, hilos, &caso->corrida) != 0) {
+                return -1;
+            }
+        }
+        tiempos[caso->repeticiones++] = (relojMonotonico() - inicio) / caso->vueltas;
+    }
+    repeticiones = caso->repeticiones;
+
+    double suma = 0;
+    for (int r = 0; r < repeticiones; r++) {
+        suma += tiempos[r];
+    }
+    caso->media = suma / repeticiones;
+    double cuadrados = 0;
+    for (int r = 0; r < repeticiones; r++) {
+        cuadrados += (tiempos[r] - caso->media) * (tiempos[r] - caso->media);
+    }
+    caso->desviacion = repeticiones > 1 ? sqrt(cuadrados / (repeticiones - 1)) : 0;
+    qsort(tiempos, repeticiones, sizeof(double), compararDoubles);
+    caso->minimo = tiempos[0];
+    caso->mediana = repeticiones % 2 ? tiempos[repeticiones / 2]
+                                     : (tiempos[repeticiones / 2 - 1] + tiempos[repeticiones / 2]) / 2;
+    caso->correcto = caso->corrida.permutaciones == conteosConocidos[caso->N];
+    return 0;
+}
+
+/**
+ * @brief Nodos por segundo con la mediana del tiempo, o 0 si el motor no cuenta nodos.
+ */
+static double nodosPorSegundo(const caso_t *caso) {
+    return caso->mediana > 0 ? caso->corrida.nodos / caso->mediana : 0;
+}
+
+static int escribirJson(const char *archivo, const caso_t *casos, int numCasos, int repeticiones, int calentamiento, int hilos) {
+    FILE *f = fopen(archivo, "w");
+    if (f == NULL) {
+        perror(archivo);
+        return -1;
+    }
+    fprintf(f, "{\n");
+    fprintf(f, "  \"procesadores\": %ld,\n", sysconf(_SC_NPROCESSORS_ONLN));
+    fprintf(f, "  \"conteo_hojas\": \"%s\",\n", nombreContadorHojas(elegirContadorHojas(1)));
+    fprintf(f, "  \"repeticiones\": %d,\n", repeticiones);
+    fprintf(f, "  \"calentamiento\": %d,\n", calentamiento);
+    fprintf(f, "  \"hilos\": %d,\n", hilos);
+    fprintf(f, "  \"resultados\": [\n");
+    for (int i = 0; i < numCasos; i++) {
+        const caso_t *c = &casos[i];
+        fprintf(f, "    {\"variante\": \"%s\", \"N\": %d, \"permutaciones\": %lu, \"esperadas\": %lu, "
+                   "\"correcto\": %s, \"repeticiones\": %d, \"nodos\": ",
+                c->variante->nombre, c->N, c->corrida.permutaciones, conteosConocidos[c->N],
+                c->correcto ? "true" : "false", c->repeticiones);
+        if (c->corrida.nodos > 0) {
+            fprintf(f, "%lu", c->corrida.nodos);
+        } else {
+            fprintf(f, "null");
+        }
+        fprintf(f, ", \"vueltas\": %d, \"segundos\": {\"minimo\": %.9f, \"mediana\": %.9f, "
+                   "\"media\": %.9f, \"desviacion\": %.9f}, \"nodos_por_segundo\": ",
+                c->vueltas, c->minimo, c->mediana, c->media, c->desviacion);
+        if (c->corrida.nodos > 0) {
+            fprintf(f, "%.0f", nodosPorSegundo(c));
+        } else {
+            fprintf(f, "null");
+        }
+        fprintf(f, "}%s\n", i + 1 < numCasos ? "," : "");
+    }
+    fprintf(f, "  ]\n");
+    fprintf(f, "}\n");
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+static int escribirCsv(const char *archivo, const caso_t *casos, int numCasos) {
+    FILE *f = fopen(archivo, "w");
+    if (f == NULL) {
+        perror(archivo);
+        return -1;
+    }
+    fprintf(f, "variante,N,permutaciones,esperadas,correcto,repeticiones,nodos,vueltas,minimo,mediana,media,desviacion,nodos_por_segundo\n");
+    for (int i = 0; i < numCasos; i++) {
+        const caso_t *c = &casos[i];
+        fprintf(f, "%s,%d,%lu,%lu,%d,%d,%lu,%d,%.9f,%.9f,%.9f,%.9f,%.0f\n", c->variante->nombre, c->N,
+                c->corrida.permutaciones, conteosConocidos[c->N], c->correcto, c->repeticiones, c->corrida.nodos,
+                c->vueltas, c->minimo, c->mediana, c->media, c->desviacion, nodosPorSegundo(c));
+    }
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+int main(int argc, char *argv[]) {
+    int desde = 8;
+    int hasta = 15;
+    int repeticiones = 5;
+    int calentamiento = 1;
+    double limite = 60;
+    long procesadores = sysconf(_SC_NPROCESSORS_ONLN);
+    int hilos = procesadores < 1 ? 1 : procesadores > MAX_HILOS ? MAX_HILOS : (int)procesadores;
+    const char *archivoJson = NULL;
+    const char *archivoCsv = NULL;
+    int elegidas[NUM_VARIANTES];
+    for (int i = 0; i < NUM_VARIANTES; i++) {
+        elegidas[i] = 1;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--desde") == 0 && i + 1 < argc) {
+            desde = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--hasta") == 0 && i + 1 < argc) {
+            hasta = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--repeticiones") == 0 && i + 1 < argc) {
+            repeticiones = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--calentamiento") == 0 && i + 1 < argc) {
+            calentamiento = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            hilos = atoi(argv[++i]);
+            if (hilos < 1 || hilos > MAX_HILOS) {
+                printf("El numero de hilos debe estar entre 1 y %d\n", MAX_HILOS);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--variantes") == 0 && i + 1 < argc) {
+            if (elegirVariantes(argv[++i], elegidas) != 0) {
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--limite") == 0 && i + 1 < argc) {
+            limite = atof(argv[++i]);
+            if (limite <= 0) {
+                printf("El limite debe ser positivo\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            archivoJson = argv[++i];
+        } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            archivoCsv = argv[++i];
+        } else {
+            printf("Opcion desconocida: %s\n", argv[i]);
+            mostrarUso(argv[0]);
+            return 1;
+        }
+    }
+    if (desde < 2 || hasta > N_BENCHMARK_MAXIMO || desde > hasta) {
+        printf("Se requiere 2 <= desde <= hasta <= %d\n", N_BENCHMARK_MAXIMO);
+        return 1;
+    }
+    if (repeticiones < 1 || repeticiones > MAX_REPETICIONES || calentamiento < 0) {
+        printf("Las repeticiones deben estar entre 1 y %d y el calentamiento no puede ser negativo\n",
+               MAX_REPETICIONES);
+        return 1;
+    }
+
+    iniciarCancelacion(&sinPlazo, 1e12);
+    caso_t casos[NUM_VARIANTES * (N_BENCHMARK_MAXIMO + 1)];
+    int numCasos = 0;
+    int fallos = 0;
+
+    printf("Conteo de hojas: %s; %d hilo(s) en las variantes paralelas; %d repeticiones\n",
+           nombreContadorHojas(elegirContadorHojas(1)), hilos, repeticiones);
+    printf("%-15s %3s %10s %4s %14s %12s %12s %9s %12s\n", "variante", "N", "perms", "ok", "nodos",
+           "mediana (s)", "minimo (s)", "desv (%)", "nodos/s");
+    for (int v = 0; v < NUM_VARIANTES; v++) {
+        if (!elegidas[v]) {
+            continue;
+        }
+        for (int N = desde; N <= hasta; N++) {
+            caso_t *caso = &casos[numCasos];
+            memset(caso, 0, sizeof(*caso));
+            caso->variante = &variantes[v];
+            caso->N = N;
+            if (medirCaso(caso, repeticiones, calentamiento, hilos) != 0) {
+                printf("No se pudo ejecutar la variante %s con N = %d\n", variantes[v].nombre, N);
+                return 1;
+            }
+            numCasos++;
+            fallos += !caso->correcto;
+            printf("%-15s %3d %10lu %4s ", caso->variante->nombre, N, caso->corrida.permutaciones,
+                   caso->correcto ? "si" : "NO");
+            if (caso->corrida.nodos > 0) {
+                printf("%14lu ", caso->corrida.nodos);
+            } else {
+                printf("%14s ", "-");
+            }
+            printf("%12.6f %12.6f %9.1f ", caso->mediana, caso->minimo,
+                   caso->media > 0 ? 100.0 * caso->desviacion / caso->media : 0.0);
+            if (caso->corrida.nodos > 0) {
+                printf("%12.4g\n", nodosPorSegundo(caso));
+            } else {
+                printf("%12s\n", "-");
+            }
+            fflush(stdout);
+            if (caso->mediana > limite && N < hasta) {
+                printf("%-15s N > %d omitidos: la busqueda supera %.0f s\n", caso->variante->nombre, N, limite);
+                break;
+            }
+        }
+    }
+
+    if (archivoJson != NULL && escribirJson(archivoJson, casos, numCasos, repeticiones, calentamiento, hilos) != 0) {
+        printf("No se pudo escribir %s\n", archivoJson);
+        return 1;
+    }
+    if (archivoCsv != NULL && escribirCsv(archivoCsv, casos, numCasos) != 0) {
+        printf("No se pudo escribir %s\n", archivoCsv);
+        return 1;
+    }
+    if (fallos > 0) {
+        printf("[AVISO] %d caso(s) con un conteo distinto del conocido\n", fallos);
+        return 1;
+    }
+    return 0;
+}
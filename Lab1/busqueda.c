@@ -0,0 +1,593 @@
+/**
+ * @file busqueda.c
+ * @brief Implementación del núcleo de búsqueda de permutaciones gráciles.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#include <string.h>
+
+#include "busqueda.h"
+#include "instrumentacion.h"
+
+static nucleoBusqueda_t elegirNucleo(const parametrosBusqueda_t *parametros);
+
+// Funcion recursiva para encontrar permutaciones graciles
+void encontrarPermutaciones(int posicionActual, int N, int arregloNumeros[], int numerosUsados[], int diferenciasUsadas[], unsigned long *totalPermutaciones, clock_t tiempoInicio, int M) {
+    // Verificar si se ha superado el tiempo limite
+    double tiempoTranscurrido = (double)(clock() - tiempoInicio) / CLOCKS_PER_SEC;
+    if (tiempoTranscurrido >= M * 60) {
+        return;
+    }
+    
+    // Si se llenaron todas las posiciones, se encontro una permutacion valida
+    if (posicionActual == N) {
+        (*totalPermutaciones)++;
+        return;
+    }
+    
+    // Intentar colocar un numero en la posicion actual
+    for (int numeroIntento = 1; numeroIntento <= N; numeroIntento++) {
+        if (!numerosUsados[numeroIntento]) {  // Si el numero no ha sido usado
+            // Si es la primera posicion o la diferencia es unica
+            if (posicionActual == 0 || !diferenciasUsadas[abs(numeroIntento - arregloNumeros[posicionActual - 1])]) {
+                arregloNumeros[posicionActual] = numeroIntento;
+                numerosUsados[numeroIntento] = 1;
+                if (posicionActual > 0) {
+                    int diferencia = abs(numeroIntento - arregloNumeros[posicionActual - 1]);
+                    diferenciasUsadas[diferencia] = 1;
+                }
+                // Llamada recursiva para la siguiente posicion
+                encontrarPermutaciones(posicionActual + 1, N, arregloNumeros, numerosUsados, diferenciasUsadas, totalPermutaciones, tiempoInicio, M);
+                // Deshacer cambios para probar otra opcion
+                if (posicionActual > 0) {
+                    int diferencia = abs(numeroIntento - arregloNumeros[posicionActual - 1]);
+                    diferenciasUsadas[diferencia] = 0;
+                }
+                numerosUsados[numeroIntento] = 0;
+            }
+        }
+    }
+}
+
+void iniciarBusquedaBits(busquedaBits_t *b, const parametrosBusqueda_t *parametros) {
+    int N = parametros->N;
+
+    memset(b, 0, sizeof(*b));
+    b->N = N;
+    b->cancelacion = parametros->cancelacion;
+    b->mascaraNumeros = ((1ULL << N) - 1) << 1;  // Bits 1..N
+    b->tabla = parametros->tabla;
+    b->tablaHasta = (b->tabla != NULL) ? N - RESTANTES_MINIMOS_TABLA : -1;
+    b->cedidoHasta = -1;
+    b->nucleo = elegirNucleo(parametros);
+    b->contarPenultimo = elegirContadorHojas(!parametros->sinSimd);
+    b->diferenciasPropagadas = parametros->sinPropagacion ? 0 : DIFERENCIAS_PROPAGADAS;
+
+    b->mascaraPrimero = b->mascaraNumeros;
+    b->posicionDoble = -1;
+    b->pesoSimple = 1;
+    for (int i = 0; i < 64; i++) {
+        b->mascaraTrasNumero[i] = b->mascaraNumeros;
+        b->mascaraPosicion[i] = b->mascaraNumeros;
+    }
+    if (!parametros->simetria) {
+        return;
+    }
+
+    // El 1 va en una posicion i <= limite, es decir i <= N-2-i
+    int limite = (N - 2) / 2;
+    uint64_t bitUno = 1ULL << 1;
+    uint64_t bitN = 1ULL << N;
+
+    b->pesoSimple = 4;
+    b->posicionDoble = (N % 2 == 0) ? limite : -1;
+    // El N solo puede ir justo despues del 1, y despues del 1 solo el N
+    b->mascaraPrimero = b->mascaraNumeros & ~bitN;
+    for (int numero = 2; numero <= N; numero++) {
+        b->mascaraTrasNumero[numero] = b->mascaraNumeros & ~bitN;
+    }
+    b->mascaraTrasNumero[1] = bitN;
+    for (int posicion = limite + 1; posicion < N; posicion++) {
+        b->mascaraPosicion[posicion] &= ~bitUno;
+    }
+    b->requeridos[limite + 1] = bitUno;
+}
+
+void fijarPrefijo(busquedaBits_t *b, const int *prefijo, int longitud) {
+    b->numerosUsados = 0;
+    b->diferenciasUsadas = 0;
+    b->diferenciasReflejadas = 0;
+    for (int i = 0; i < longitud; i++) {
+        alternarNumero(b, i, prefijo[i]);
+    }
+}
+
+void aplicarPrefijo(busquedaBits_t *b, const tareaBusqueda_t *tarea) {
+    fijarPrefijo(b, tarea->prefijo, tarea->longitud);
+}
+
+void encontrarPermutacionesBits(busquedaBits_t *b, int posicionActual) {
+    // Verificar el tiempo limite solo cada cierta cantidad de nodos
+    if ((++b->nodos & MASCARA_CHEQUEO_TIEMPO) == 0 && revisarPlazo(b->cancelacion)) {
+        b->tiempoAgotado = 1;
+    }
+    if (b->tiempoAgotado) {
+        return;
+    }
+
+    uint64_t candidatos = candidatosBits(b, posicionActual);
+
+    // En la ultima posicion cada candidato es una permutacion valida
+    if (posicionActual == b->N - 1) {
+        contarHojas(b, candidatos);
+        return;
+    }
+
+    while (candidatos) {
+        int numeroIntento = __builtin_ctzll(candidatos);
+        candidatos &= candidatos - 1;
+
+        alternarNumero(b, posicionActual, numeroIntento);
+        encontrarPermutacionesBits(b, posicionActual + 1);
+        // Deshacer cambios para probar otra opcion
+        alternarNumero(b, posicionActual, numeroIntento);
+    }
+}
+
+/**
+ * @brief Escribe la permutación completa del estado y las de su clase que representa.
+ *
+ * Con simetría, una hoja de peso 2 representa también a su complemento, y
+ * una de peso 4 a su complemento, su reverso y el reverso del complemento
+ * (ver iniciarBusquedaBits()).
+ *
+ * @param b Estado con las N posiciones llenas y bloque de salida.
+ * @param peso Peso de la hoja.
+ */
+static void escribirClase(busquedaBits_t *b, int peso) {
+    const int N = b->N;
+    const int *permutacion = b->arregloNumeros;
+    int otra[64];
+
+    escribirPermutacion(b->salida, permutacion);
+    if (peso == 1) {
+        return;
+    }
+    for (int j = 0; j < N; j++) {
+        otra[j] = N + 1 - permutacion[j];
+    }
+    escribirPermutacion(b->salida, otra);
+    if (peso == 4) {
+        for (int j = 0; j < N; j++) {
+            otra[j] = permutacion[N - 1 - j];
+        }
+        escribirPermutacion(b->salida, otra);
+        for (int j = 0; j < N; j++) {
+            otra[j] = N + 1 - permutacion[N - 1 - j];
+        }
+        escribirPermutacion(b->salida, otra);
+    }
+}
+
+/**
+ * @brief Escribe las permutaciones que completan los candidatos de la última posición.
+ *
+ * @param b Estado con las primeras N-1 posiciones llenas y bloque de salida.
+ * @param candidatos Candidatos válidos de la última posición.
+ */
+static void escribirHojas(busquedaBits_t *b, uint64_t candidatos) {
+    int peso = pesoHoja(b);
+    for (; candidatos; candidatos &= candidatos - 1) {
+        b->arregloNumeros[b->N - 1] = __builtin_ctzll(candidatos);
+        escribirClase(b, peso);
+    }
+}
+
+void iniciarTarea(busquedaBits_t *b, int base, uint64_t candidatos, double peso) {
+    b->base = base;
+    b->pesoTarea = peso;
+    b->pesoCedido = 0;
+    b->cedidoHasta = -1;
+    if (base == b->N - 1) {
+        // En la ultima posicion cada candidato es una permutacion valida
+        contarHojas(b, candidatos);
+        CONTAR_NIVEL(b, b->N, __builtin_popcountll(candidatos));
+        if (b->salida != NULL) {
+            escribirHojas(b, candidatos);
+        }
+        b->posicion = base - 1;
+        b->pesoCompletado += peso;
+        b->pesoTarea = 0;
+        return;
+    }
+    b->pila[base] = candidatos;
+    b->iniciales[base] = candidatos;
+    b->posicion = base;
+}
+
+/**
+ * @brief Coloca o quita un número usando copias locales de las máscaras.
+ *
+ * Es alternarNumero() para el núcleo iterativo: las máscaras viven en
+ * variables locales durante toda la rebanada y no en el estado, así el
+ * compilador las deja en registros en lugar de volver a leerlas de memoria
+ * después de cada escritura en la pila.
+ */
+static inline __attribute__((always_inline)) void alternarLocal(int *arreglo, int posicion, int numero, uint64_t *usados,
+                                                                uint64_t *diferencias, uint64_t *reflejadas) {
+    arreglo[posicion] = numero;
+    *usados ^= 1ULL << numero;
+    if (posicion > 0) {
+        int diferencia = abs(numero - arreglo[posicion - 1]);
+        *diferencias ^= 1ULL << diferencia;
+        *reflejadas ^= 1ULL << (63 - diferencia);
+    }
+}
+
+/**
+ * @brief Cuerpo del motor iterativo; se instancia para cada combinación de opciones.
+ *
+ * Los tres últimos parámetros son constantes en cada instancia y el
+ * compilador quita del ciclo lo que no aplica:
+ * - sin tabla desaparece todo el código de la tabla de transposición;
+ * - sin simetría no se leen las máscaras por posición ni los requeridos,
+ *   que en ese caso no restringen nada, y cada hoja pesa 1;
+ * - con `nFijo` > 0 la máscara de números y la última posición son
+ *   constantes de compilación;
+ * - con salida se escribe cada hoja y la penúltima posición se apila como
+ *   las demás (también en la compilación instrumentada, para contar cada
+ *   nivel por separado).
+ *
+ * @param b Estado de la búsqueda.
+ * @param presupuesto Nodos a visitar como máximo.
+ * @param conTabla 1 si se consulta y llena la tabla de transposición.
+ * @param conSimetria 1 si se aplican las máscaras de la reducción por simetría.
+ * @param nFijo Tamaño N de la instancia, o 0 para leerlo del estado.
+ * @param conSalida 1 si se escribe cada permutación en el bloque de salida.
+ * @return int 1 si la tarea tiene trabajo pendiente, 0 si terminó.
+ */
+static inline __attribute__((always_inline)) int recorrerRebanada(busquedaBits_t *b, unsigned long presupuesto, const int conTabla,
+                                                                  const int conSimetria, const int nFijo, const int conSalida) {
+    const int ultima = (nFijo > 0 ? nFijo : b->N) - 1;
+    const uint64_t mascaraNumeros = nFijo > 0 ? ((1ULL << nFijo) - 1) << 1 : b->mascaraNumeros;
+    int *arreglo = b->arregloNumeros;
+    uint64_t *pila = b->pila;
+    int posicion = b->posicion;
+    int base = b->base;
+    uint64_t usados = b->numerosUsados;
+    uint64_t diferencias = b->diferenciasUsadas;
+    uint64_t reflejadas = b->diferenciasReflejadas;
+    unsigned long nodos = b->nodos;
+    unsigned long total = b->totalPermutaciones;
+    unsigned long limite = nodos + presupuesto;
+    const int revisar = b->diferenciasPropagadas;
+    const uint64_t mascaraDiferencias = (mascaraNumeros >> 1) & ~1ULL;
+
+    while (posicion >= base) {
+        uint64_t pendientes = pila[posicion];
+        if (pendientes == 0) {
+            // Se agotaron los hermanos: volver al nivel anterior
+            if (--posicion >= base) {
+                // El subarbol quedo completo si no se cedio parte de el
+                if (conTabla && posicion + 1 <= b->tablaHasta && posicion + 1 > b->cedidoHasta && b->iniciales[posicion + 1]) {
+                    guardarEnTabla(b->tabla, claveSubarbol(b, usados, posicion + 1), diferencias,
+                                   total - b->totalAlEntrar[posicion + 1]);
+                }
+                alternarLocal(arreglo, posicion, arreglo[posicion], &usados, &diferencias, &reflejadas);
+            }
+            continue;
+        }
+        if (nodos >= limite) {
+            break;
+        }
+
+        int numeroIntento = __builtin_ctzll(pendientes);
+        pila[posicion] = pendientes & (pendientes - 1);
+        alternarLocal(arreglo, posicion, numeroIntento, &usados, &diferencias, &reflejadas);
+        nodos++;
+        CONTAR_NIVEL(b, posicion + 1, 1);
+
+        // Candidatos de la posicion siguiente (como candidatosBits, con anterior = numeroIntento)
+        uint64_t siguientes = mascaraNumeros & ~usados &
+                              ~((diferencias << numeroIntento) | (reflejadas >> (63 - numeroIntento)));
+        if (conSimetria) {
+            siguientes &= b->mascaraTrasNumero[numeroIntento] & b->mascaraPosicion[posicion + 1];
+            if (b->requeridos[posicion + 1] & ~usados) {
+                siguientes = 0;
+            }
+        }
+        if (posicion + 1 < ultima) {
+            siguientes = propagarDiferencias(siguientes, mascaraNumeros & ~usados, mascaraDiferencias & ~diferencias,
+                                             numeroIntento, revisar);
+        }
+        uint64_t conteo;
+        if (INSTRUMENTADO && siguientes == 0) {
+            CONTAR_SIN_SALIDA(b, posicion + 1);
+        }
+        if (posicion + 1 == ultima) {
+            // Como contarHojas(): cada candidato es una permutacion valida
+            int hojas = __builtin_popcountll(siguientes);
+            nodos += hojas;
+            CONTAR_NIVEL(b, ultima + 1, hojas);
+            total += (unsigned long)hojas * (conSimetria ? pesoHoja(b) : 1);
+            if (conSalida) {
+                escribirHojas(b, siguientes);
+            }
+            alternarLocal(arreglo, posicion, numeroIntento, &usados, &diferencias, &reflejadas);
+        } else if (!conSalida && !INSTRUMENTADO && posicion + 2 == ultima) {
+            // Los hermanos de la penultima posicion se cuentan juntos, sin apilarlos
+            nivelPenultimo_t nivel = {
+                .anterior = numeroIntento,
+                .numerosUsados = usados,
+                .diferenciasUsadas = diferencias,
+                .diferenciasReflejadas = reflejadas,
+                .mascaraUltima = conSimetria ? mascaraNumeros & b->mascaraPosicion[ultima] : mascaraNumeros,
+                .requeridosUltima = conSimetria ? b->requeridos[ultima] : 0,
+                .mascaraTrasNumero = conSimetria ? b->mascaraTrasNumero : NULL,
+            };
+            unsigned long hojas = 0;
+            if (siguientes & (siguientes - 1)) {
+                hojas = b->contarPenultimo(&nivel, siguientes);
+            } else if (siguientes) {
+                // Un solo hermano, el caso mas comun: no vale la pena llamar a la version vectorial
+                hojas = __builtin_popcountll(candidatosUltima(&nivel, __builtin_ctzll(siguientes)));
+            }
+            nodos += __builtin_popcountll(siguientes) + hojas;
+            total += hojas * (conSimetria ? pesoHoja(b) : 1);
+            alternarLocal(arreglo, posicion, numeroIntento, &usados, &diferencias, &reflejadas);
+        } else if (conTabla && posicion + 1 <= b->tablaHasta && siguientes && (b->consultasTabla++,
+                   buscarEnTabla(b->tabla, claveSubarbol(b, usados, posicion + 1), diferencias, &conteo))) {
+            // El mismo subarbol ya se conto por otro camino
+            b->aciertosTabla++;
+            total += conteo;
+            alternarLocal(arreglo, posicion, numeroIntento, &usados, &diferencias, &reflejadas);
+        } else {
+            pila[++posicion] = siguientes;
+            b->iniciales[posicion] = siguientes;
+            if (conTabla && posicion <= b->tablaHasta) {
+                b->totalAlEntrar[posicion] = total;
+                if (b->cedidoHasta >= posicion) {
+                    b->cedidoHasta = posicion - 1;  // Nivel nuevo, todavia completo
+                }
+            }
+        }
+    }
+
+    b->posicion = posicion;
+    b->numerosUsados = usados;
+    b->diferenciasUsadas = diferencias;
+    b->diferenciasReflejadas = reflejadas;
+    b->nodos = nodos;
+    b->totalPermutaciones = total;
+    if (posicion < base && b->pesoTarea > 0) {
+        // Tarea terminada: todo lo que no se cedio quedo explorado
+        b->pesoCompletado += b->pesoTarea - b->pesoCedido;
+        b->pesoTarea = 0;
+    }
+    return posicion >= base;
+}
+
+/** @brief Núcleo genérico: N se lee del estado y siempre se aplican las máscaras de simetría. */
+static int nucleoGenerico(busquedaBits_t *b, unsigned long presupuesto) {
+    return recorrerRebanada(b, presupuesto, 0, 1, 0, 0);
+}
+
+/** @brief Núcleo genérico con tabla de transposición. */
+static int nucleoGenericoTabla(busquedaBits_t *b, unsigned long presupuesto) {
+    return recorrerRebanada(b, presupuesto, 1, 1, 0, 0);
+}
+
+/** @brief Núcleo genérico que escribe cada permutación encontrada. */
+static int nucleoGenericoSalida(busquedaBits_t *b, unsigned long presupuesto) {
+    return recorrerRebanada(b, presupuesto, 0, 1, 0, 1);
+}
+
+/** @brief Lista de los N con núcleo especializado (2..N_MAXIMO). */
+#define PARA_CADA_N(X) \
+    X(2)  X(3)  X(4)  X(5)  X(6)  X(7)  X(8)  X(9)  X(10) X(11) X(12) X(13) X(14) X(15) X(16) X(17) \
+    X(18) X(19) X(20) X(21) X(22) X(23) X(24) X(25) X(26) X(27) X(28) X(29) X(30) X(31) X(32) X(33) \
+    X(34) X(35) X(36) X(37) X(38) X(39) X(40) X(41) X(42) X(43) X(44) X(45) X(46) X(47) X(48) X(49)
+
+// Una instancia sin simetria y otra con simetria para cada N
+#define DEFINIR_NUCLEOS(n) \
+    static int nucleo##n(busquedaBits_t *b, unsigned long presupuesto) { \
+        return recorrerRebanada(b, presupuesto, 0, 0, n, 0); \
+    } \
+    static int nucleoSimetria##n(busquedaBits_t *b, unsigned long presupuesto) { \
+        return recorrerRebanada(b, presupuesto, 0, 1, n, 0); \
+    }
+PARA_CADA_N(DEFINIR_NUCLEOS)
+
+#define ENTRADA_NUCLEOS(n) [n] = {nucleo##n, nucleoSimetria##n},
+static const nucleoBusqueda_t nucleosEspecializados[N_MAXIMO + 1][2] = {
+    PARA_CADA_N(ENTRADA_NUCLEOS)
+};
+
+/**
+ * @brief Elige la instancia del núcleo iterativo para unos parámetros.
+ *
+ * La tabla de transposición y la salida solo tienen núcleo genérico: cada
+ * consulta o escritura cuesta mucho más que lo que se ahorra al especializar.
+ *
+ * @param parametros Parámetros de la búsqueda.
+ * @return nucleoBusqueda_t Función que avanza una rebanada.
+ */
+static nucleoBusqueda_t elegirNucleo(const parametrosBusqueda_t *parametros) {
+    if (parametros->salida != NULL) {
+        return nucleoGenericoSalida;
+    }
+    if (parametros->tabla != NULL) {
+        return nucleoGenericoTabla;
+    }
+    if (parametros->nucleoGenerico || parametros->N < 2 || parametros->N > N_MAXIMO) {
+        return nucleoGenerico;
+    }
+    return nucleosEspecializados[parametros->N][parametros->simetria != 0];
+}
+
+int avanzarBusqueda(busquedaBits_t *b, unsigned long presupuesto) {
+    int pendiente = b->nucleo(b, presupuesto);
+#ifdef INSTRUMENTAR
+    publicarNodos(b);
+#endif
+    return pendiente;
+}
+
+void completarTarea(busquedaBits_t *b) {
+    while (avanzarBusqueda(b, PRESUPUESTO_REBANADA)) {
+        if (revisarPlazo(b->cancelacion)) {
+            b->tiempoAgotado = 1;
+            return;
+        }
+    }
+}
+
+double pesoHermano(const busquedaBits_t *b, int nivel) {
+    double peso = b->pesoTarea;
+    for (int p = b->base; p <= nivel; p++) {
+        peso /= __builtin_popcountll(b->iniciales[p]);
+    }
+    return peso;
+}
+
+double fraccionExplorada(const busquedaBits_t *b) {
+    double explorado = b->pesoCompletado;
+    if (b->pesoTarea == 0 || b->posicion < b->base) {
+        return explorado;
+    }
+
+    // Hermanos terminados (o cedidos) en cada nivel de la pila; en los
+    // niveles por encima de la posicion actual hay uno en curso
+    // El peso de cada nivel sale del anterior, como en pesoHermano()
+    double parte = 0;
+    double peso = b->pesoTarea;
+    for (int p = b->base; p <= b->posicion; p++) {
+        int total = __builtin_popcountll(b->iniciales[p]);
+        int terminados = total - __builtin_popcountll(b->pila[p]) - (p < b->posicion ? 1 : 0);
+        peso /= total;
+        parte += peso * terminados;
+    }
+    return explorado + parte - b->pesoCedido;
+}
+
+int extraerPendientes(const busquedaBits_t *b, tareaBusqueda_t *tareas) {
+    int numTareas = 0;
+    // Si la tarea termino, posicion < base y no hay niveles
+    for (int p = b->base; p <= b->posicion; p++) {
+        if (b->pila[p] == 0) {
+            continue;
+        }
+        tareaBusqueda_t *tarea = &tareas[numTareas++];
+        tarea->longitud = p;
+        tarea->candidatos = b->pila[p];
+        tarea->peso = pesoHermano(b, p) * __builtin_popcountll(b->pila[p]);
+        memcpy(tarea->prefijo, b->arregloNumeros, p * sizeof(int));
+    }
+    return numTareas;
+}
+
+/**
+ * @brief Estado del recorrido que genera los prefijos de un fragmento.
+ */
+typedef struct {
+    int longitud;               ///< Posiciones a fijar.
+    int fragmento;              ///< Fragmento que se genera (0..fragmentos-1).
+    int fragmentos;             ///< Partes en que se reparten los prefijos.
+    unsigned long indice;       ///< Prefijos de la longitud pedida vistos hasta ahora.
+    tareaBusqueda_t *tareas;    ///< Salida, o NULL para solo contar.
+    int numTareas;              ///< Tareas escritas.
+    double peso;                ///< Suma de los pesos de los prefijos del fragmento.
+} recorridoPrefijos_t;
+
+// Recorre el arbol hasta la longitud pedida y guarda cada prefijo alcanzado
+static void recorrerPrefijos(busquedaBits_t *b, recorridoPrefijos_t *r, int posicionActual, double peso) {
+    if (posicionActual == r->longitud) {
+        // Los prefijos se reparten en orden entre los fragmentos
+        if (r->indice++ % (unsigned long)r->fragmentos != (unsigned long)r->fragmento) {
+            return;
+        }
+        b->nodos++;
+        CONTAR_NIVEL(b, posicionActual, 1);
+        r->peso += peso;
+        uint64_t candidatos = candidatosBits(b, posicionActual);
+        if (INSTRUMENTADO && candidatos == 0 && posicionActual < b->N) {
+            CONTAR_SIN_SALIDA(b, posicionActual);
+        }
+        if (candidatos == 0 || r->tareas == NULL) {
+            return;  // Prefijo sin salida: ya quedo explorado
+        }
+        tareaBusqueda_t *tarea = &r->tareas[r->numTareas++];
+        tarea->longitud = r->longitud;
+        tarea->candidatos = candidatos;
+        tarea->peso = peso;
+        memcpy(tarea->prefijo, b->arregloNumeros, r->longitud * sizeof(int));
+        return;
+    }
+
+    // Los nodos internos no los cuenta ninguna tarea; de ellos se encarga
+    // el primer fragmento para que la suma de los fragmentos sea exacta
+    if (r->fragmento == 0) {
+        b->nodos++;
+        CONTAR_NIVEL(b, posicionActual, 1);
+    }
+
+    uint64_t candidatos = candidatosBits(b, posicionActual);
+    if (INSTRUMENTADO && r->fragmento == 0 && candidatos == 0) {
+        CONTAR_SIN_SALIDA(b, posicionActual);
+    }
+    int hijos = __builtin_popcountll(candidatos);
+    double pesoHijo = hijos > 0 ? peso / hijos : 0;
+    while (candidatos) {
+        int numeroIntento = __builtin_ctzll(candidatos);
+        candidatos &= candidatos - 1;
+
+        alternarNumero(b, posicionActual, numeroIntento);
+        recorrerPrefijos(b, r, posicionActual + 1, pesoHijo);
+        alternarNumero(b, posicionActual, numeroIntento);
+    }
+}
+
+int generarFragmento(const parametrosBusqueda_t *parametros, int longitud, int fragmento, int fragmentos, tareaBusqueda_t *tareas, unsigned long *nodos, double *peso) {
+    busquedaBits_t b;
+    recorridoPrefijos_t r;
+
+    memset(&r, 0, sizeof(r));
+    r.longitud = longitud;
+    r.fragmento = fragmento;
+    r.fragmentos = fragmentos;
+    r.tareas = tareas;
+
+    iniciarBusquedaBits(&b, parametros);
+    recorrerPrefijos(&b, &r, 0, 1.0);
+    if (nodos != NULL) {
+        *nodos += b.nodos;
+#ifdef INSTRUMENTAR
+        registrarNiveles(&b);
+        publicarNodos(&b);
+#endif
+    }
+    if (peso != NULL) {
+        *peso = r.peso;
+    }
+    return r.numTareas;
+}
+
+int generarPrefijos(const parametrosBusqueda_t *parametros, int longitud, tareaBusqueda_t *tareas, unsigned long *nodos) {
+    return generarFragmento(parametros, longitud, 0, 1, tareas, nodos, NULL);
+}
+
+unsigned long contarPrefijos(const parametrosBusqueda_t *parametros, int longitud) {
+    busquedaBits_t b;
+    recorridoPrefijos_t r;
+
+    memset(&r, 0, sizeof(r));
+    r.longitud = longitud;
+    r.fragmentos = 1;
+
+    iniciarBusquedaBits(&b, parametros);
+    recorrerPrefijos(&b, &r, 0, 1.0);
+    return r.indice;
+}
@@ -0,0 +1,483 @@
+/**
+ * @file busqueda.h
+ * @brief Núcleo de búsqueda de permutaciones gráciles.
+ *
+ * Define el estado de búsqueda con máscaras de bits, el motor recursivo
+ * original (usado como referencia) y la generación de prefijos que usan los
+ * modos paralelos para repartir el árbol de búsqueda.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#ifndef BUSQUEDA_H
+#define BUSQUEDA_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "cancelacion.h"
+#include "hojas.h"
+#include "salida.h"
+#include "transposicion.h"
+
+#define N_MAXIMO 49 ///< Mayor N aceptado (N < 50).
+
+/**
+ * @brief Cada cuantos nodos los motores de bits consultan el reloj.
+ *
+ * Debe ser una potencia de dos menos uno para usarla como mascara.
+ */
+#define MASCARA_CHEQUEO_TIEMPO 0xFFFu
+
+/** @brief Nodos que avanza el motor iterativo entre dos consultas del reloj. */
+#define PRESUPUESTO_REBANADA (MASCARA_CHEQUEO_TIEMPO + 1)
+
+#define LONGITUD_PREFIJO_MAXIMA 2 ///< Posiciones fijadas por cada tarea de prefijo.
+
+/**
+ * @brief Posiciones por llenar que debe tener un subárbol para usar la tabla de transposición.
+ *
+ * Cada consulta es casi siempre un fallo de caché, que cuesta lo mismo que
+ * recorrer varios nodos; los subárboles más pequeños sale más barato
+ * recorrerlos otra vez.
+ */
+#define RESTANTES_MINIMOS_TABLA 8
+
+/**
+ * @brief Diferencias libres más grandes que se revisan en cada nodo (ver propagarDiferencias()).
+ *
+ * Las diferencias grandes solo salen de pocos pares (N-1 solo de 1 y N),
+ * así que son las primeras en volverse imposibles; revisar más cuesta más
+ * de lo que poda.
+ */
+#define DIFERENCIAS_PROPAGADAS 4
+
+/**
+ * @brief Estadísticas por nivel del motor iterativo (solo al compilar con -DINSTRUMENTAR).
+ *
+ * El nivel de un nodo es el número de posiciones colocadas: 0 es la raíz y
+ * N son las hojas. Sin INSTRUMENTAR las macros no generan código.
+ */
+#ifdef INSTRUMENTAR
+#define INSTRUMENTADO 1
+#define CONTAR_NIVEL(b, nivel, cantidad) ((b)->nodosNivel[nivel] += (cantidad))
+#define CONTAR_SIN_SALIDA(b, nivel) ((b)->sinSalidaNivel[nivel]++)
+#else
+#define INSTRUMENTADO 0
+#define CONTAR_NIVEL(b, nivel, cantidad) ((void)0)
+#define CONTAR_SIN_SALIDA(b, nivel) ((void)0)
+#endif
+
+/**
+ * @brief Parámetros comunes a todos los motores de búsqueda.
+ */
+typedef struct {
+    int N;                      ///< Tamaño del conjunto de números.
+    int simetria;               ///< 1 para contar solo representantes canónicos.
+    cancelacion_t *cancelacion; ///< Plazo y bandera de parada compartidos.
+    tablaTransposicion_t *tabla; ///< Tabla compartida de subárboles ya contados, o NULL.
+    int nucleoGenerico;         ///< 1 para usar el núcleo iterativo genérico en lugar del especializado.
+    int sinSimd;                ///< 1 para contar las hojas sin instrucciones vectoriales.
+    int sinPropagacion;         ///< 1 para no podar con las diferencias grandes que faltan.
+    archivoSalida_t *salida;    ///< Archivo donde escribir cada permutación encontrada, o NULL.
+} parametrosBusqueda_t;
+
+struct busquedaBits;
+
+/**
+ * @brief Instancia del núcleo iterativo: avanza una rebanada de la tarea actual.
+ *
+ * Ver avanzarBusqueda().
+ */
+typedef int (*nucleoBusqueda_t)(struct busquedaBits *b, unsigned long presupuesto);
+
+/**
+ * @brief Estado de la busqueda con conjuntos representados como mascaras de bits.
+ *
+ * Como N < 50, tanto los numeros usados (1..N) como las diferencias usadas
+ * (1..N-1) caben en una palabra de 64 bits. Las diferencias se guardan dos
+ * veces: en orden directo (bit d) y reflejadas (bit 63 - d), para poder
+ * descartar con un solo desplazamiento los candidatos x = anterior + d y
+ * x = anterior - d.
+ */
+typedef struct busquedaBits {
+    int N;                          ///< Tamaño del conjunto de números.
+    cancelacion_t *cancelacion;     ///< Plazo y bandera de parada compartidos.
+    int tiempoAgotado;              ///< Se pone en 1 si la búsqueda se detuvo antes de terminar.
+    uint64_t mascaraNumeros;        ///< Bits 1..N encendidos.
+    uint64_t numerosUsados;         ///< Bit x encendido si x ya está en la permutación.
+    uint64_t diferenciasUsadas;     ///< Bit d encendido si la diferencia d ya se usó.
+    uint64_t diferenciasReflejadas; ///< Bit 63 - d encendido si la diferencia d ya se usó.
+    unsigned long nodos;            ///< Nodos visitados del árbol de búsqueda.
+    unsigned long totalPermutaciones; ///< Permutaciones gráciles encontradas.
+    int arregloNumeros[64];         ///< Permutación parcial actual.
+    uint64_t mascaraPrimero;        ///< Números permitidos en la primera posición.
+    uint64_t mascaraTrasNumero[64]; ///< Números permitidos después de cada número.
+    uint64_t mascaraPosicion[64];   ///< Números permitidos en cada posición.
+    uint64_t requeridos[64];        ///< Números que deben estar usados al llegar a cada posición.
+    int diferenciasPropagadas;      ///< Diferencias libres que revisa propagarDiferencias() (0: ninguna).
+    int posicionDoble;              ///< Posición del 1 cuyas hojas pesan 2, o -1.
+    int pesoSimple;                 ///< Permutaciones que representa cada hoja.
+    /**
+     * Pila explícita del motor iterativo: una entrada por posición con los
+     * candidatos que faltan por probar en ella (el cursor del nivel).
+     */
+    uint64_t pila[64];
+    uint64_t iniciales[64];         ///< Candidatos que tenía cada nivel al crearse.
+    int base;                       ///< Posición donde empieza la tarea actual.
+    int posicion;                   ///< Posición actual; menor que `base` al terminar.
+    /**
+     * Fracción del árbol completo que cubre la tarea actual, suponiendo que
+     * cada nodo reparte su fracción en partes iguales entre sus hijos.
+     */
+    double pesoTarea;
+    double pesoCedido;              ///< Parte de la tarea actual entregada a otros hilos.
+    double pesoCompletado;          ///< Suma de las partes de las tareas ya terminadas.
+    tablaTransposicion_t *tabla;    ///< Tabla de transposición, o NULL.
+    int tablaHasta;                 ///< Última posición cuyo subárbol se guarda en la tabla (-1 sin tabla).
+    /** Nivel más profundo de la pila que cedió candidatos; sus subárboles están incompletos. */
+    int cedidoHasta;
+    unsigned long totalAlEntrar[64]; ///< Permutaciones contadas al crear cada nivel.
+    unsigned long consultasTabla;   ///< Consultas a la tabla de transposición.
+    unsigned long aciertosTabla;    ///< Consultas que encontraron el subárbol.
+    nucleoBusqueda_t nucleo;        ///< Instancia del núcleo iterativo para N y las opciones.
+    contadorHojas_t contarPenultimo; ///< Conteo de las dos últimas posiciones (escalar o vectorial).
+    /** Bloque propio donde escribir las permutaciones; lo asigna el dueño del estado si hay salida. */
+    bufferSalida_t *salida;
+#ifdef INSTRUMENTAR
+    unsigned long nodosNivel[64];     ///< Nodos visitados en cada nivel.
+    unsigned long sinSalidaNivel[64]; ///< Nodos de cada nivel (menor que N) sin candidatos.
+    unsigned long nodosPublicados;    ///< Parte de `nodos` ya sumada a la serie de tiempo.
+#endif
+} busquedaBits_t;
+
+/**
+ * @brief Subproblema independiente: un prefijo fijo y los candidatos de la
+ * siguiente posición que faltan por explorar.
+ *
+ * Es la unidad de trabajo de todos los modos con tareas: los prefijos del
+ * reparto estático, el trabajo robado y la frontera guardada en un punto de
+ * control. El nodo del prefijo ya lo contó quien creó la tarea.
+ */
+typedef struct {
+    int longitud;                   ///< Posiciones fijadas por el prefijo.
+    uint64_t candidatos;            ///< Candidatos pendientes para la posición `longitud`.
+    double peso;                    ///< Fracción del árbol que cubren los candidatos.
+    int prefijo[N_MAXIMO];          ///< Valores de las posiciones fijadas.
+} tareaBusqueda_t;
+
+/**
+ * @brief Descarta los candidatos que dejarían sin formar una diferencia grande.
+ *
+ * Cada diferencia que falta la tiene que formar un par de números vecinos
+ * entre los que quedan: los libres y el último colocado. Si en ese conjunto
+ * no hay dos números a distancia d, el único modo de usar d es colocar ahora
+ * el número a distancia d del anterior; si eso pasa con dos diferencias a
+ * la vez, el nodo no tiene salida. Es una condición necesaria, así que nunca
+ * descarta una permutación grácil.
+ *
+ * @param candidatos Candidatos de la posición que se va a llenar.
+ * @param libres Números sin usar; el anterior no está entre ellos.
+ * @param faltantes Diferencias sin usar (bits 1..N-1).
+ * @param anterior Último número colocado.
+ * @param revisar Cuántas de las diferencias faltantes más grandes revisar.
+ * @return uint64_t Candidatos que pueden completar las diferencias revisadas.
+ */
+static inline uint64_t propagarDiferencias(uint64_t candidatos, uint64_t libres, uint64_t faltantes, int anterior, int revisar) {
+    // El siguiente numero es libre y pasa a ser el ultimo: los que quedan son los libres de ahora
+    for (int k = 0; k < revisar && faltantes; k++) {
+        int d = 63 - __builtin_clzll(faltantes);
+        faltantes ^= 1ULL << d;
+        if ((libres & (libres >> d)) == 0) {
+            uint64_t pareja = anterior > d ? 1ULL << (anterior - d) : 0;
+            if (anterior + d < 64) {
+                pareja |= 1ULL << (anterior + d);
+            }
+            candidatos &= pareja;
+        }
+    }
+    return candidatos;
+}
+
+/**
+ * @brief Calcula los candidatos válidos para una posición de la permutación.
+ *
+ * Un candidato es válido si no se ha usado y si su diferencia con el
+ * elemento anterior no se ha usado. Las diferencias prohibidas se obtienen
+ * desplazando las máscaras de diferencias según el elemento anterior. Antes
+ * de la última posición también se descartan los que no dejan formar las
+ * diferencias grandes que faltan (ver propagarDiferencias()).
+ *
+ * @param b Estado de la búsqueda.
+ * @param posicionActual Posición que se va a llenar.
+ * @return uint64_t Máscara con un bit encendido por cada candidato válido.
+ */
+static inline uint64_t candidatosBits(const busquedaBits_t *b, int posicionActual) {
+    if (posicionActual == 0) {
+        return b->mascaraPrimero;
+    }
+    int anterior = b->arregloNumeros[posicionActual - 1];
+    uint64_t candidatos = b->mascaraNumeros & ~b->numerosUsados &
+                          ~((b->diferenciasUsadas << anterior) | (b->diferenciasReflejadas >> (63 - anterior))) &
+                          b->mascaraTrasNumero[anterior] & b->mascaraPosicion[posicionActual];
+    // Sin candidatos si falta un numero que ya debia estar colocado
+    if (b->requeridos[posicionActual] & ~b->numerosUsados) {
+        return 0;
+    }
+    if (posicionActual < b->N - 1) {
+        candidatos = propagarDiferencias(candidatos, b->mascaraNumeros & ~b->numerosUsados,
+                                         (b->mascaraNumeros >> 1) & ~1ULL & ~b->diferenciasUsadas,
+                                         anterior, b->diferenciasPropagadas);
+    }
+    return candidatos;
+}
+
+/**
+ * @brief Permutaciones que representa cada hoja bajo la permutación parcial actual.
+ *
+ * Vale 1 sin simetría; con simetría depende de si el 1 quedó en la posición
+ * de peso doble.
+ *
+ * @param b Estado de la búsqueda.
+ * @return int Peso de cada hoja.
+ */
+static inline int pesoHoja(const busquedaBits_t *b) {
+    return (b->posicionDoble >= 0 && b->arregloNumeros[b->posicionDoble] == 1) ? 2 : b->pesoSimple;
+}
+
+/**
+ * @brief Cuenta las permutaciones que completan los candidatos de la última posición.
+ *
+ * Cada candidato válido es un nodo hoja y una permutación grácil; con
+ * reducción por simetría cada hoja representa a varias permutaciones.
+ *
+ * @param b Estado de la búsqueda.
+ * @param candidatos Candidatos válidos de la última posición.
+ */
+static inline void contarHojas(busquedaBits_t *b, uint64_t candidatos) {
+    int hojas = __builtin_popcountll(candidatos);
+    int peso = pesoHoja(b);
+    b->nodos += hojas;
+    b->totalPermutaciones += (unsigned long)hojas * peso;
+}
+
+/**
+ * @brief Primera palabra de la clave del subárbol que empieza en una posición.
+ *
+ * Junta los números usados (bits 1..N), el último número (bits 50..55) y,
+ * con simetría, si el 1 quedó en la posición de peso doble (bit 56), porque
+ * eso cambia lo que vale cada hoja. La segunda palabra son las diferencias usadas.
+ *
+ * @param b Estado de la búsqueda.
+ * @param numerosUsados Números usados hasta la posición anterior.
+ * @param posicionActual Posición que se va a llenar (mayor que 0).
+ * @return uint64_t Clave, nunca 0.
+ */
+static inline uint64_t claveSubarbol(const busquedaBits_t *b, uint64_t numerosUsados, int posicionActual) {
+    uint64_t doble = b->posicionDoble >= 0 && posicionActual > b->posicionDoble &&
+                     b->arregloNumeros[b->posicionDoble] == 1;
+    return numerosUsados | (uint64_t)b->arregloNumeros[posicionActual - 1] << 50 | doble << 56;
+}
+
+/**
+ * @brief Coloca un número en una posición y marca su número y diferencia.
+ *
+ * Como las marcas se alternan con XOR, la misma función deshace el cambio
+ * si se llama de nuevo con los mismos argumentos.
+ *
+ * @param b Estado de la búsqueda.
+ * @param posicion Posición donde se coloca el número.
+ * @param numero Número a colocar (1..N).
+ */
+static inline void alternarNumero(busquedaBits_t *b, int posicion, int numero) {
+    b->arregloNumeros[posicion] = numero;
+    b->numerosUsados ^= 1ULL << numero;
+    if (posicion > 0) {
+        int diferencia = abs(numero - b->arregloNumeros[posicion - 1]);
+        b->diferenciasUsadas ^= 1ULL << diferencia;
+        b->diferenciasReflejadas ^= 1ULL << (63 - diferencia);
+    }
+}
+
+/**
+ * @brief Encuentra permutaciones gráciles de forma recursiva (motor original).
+ *
+ * @param posicionActual Posición actual en el arreglo de permutaciones.
+ * @param N Tamaño del conjunto de números.
+ * @param arregloNumeros Arreglo que almacena la permutación actual.
+ * @param numerosUsados Arreglo de seguimiento de números ya utilizados.
+ * @param diferenciasUsadas Arreglo de seguimiento de diferencias utilizadas.
+ * @param totalPermutaciones Contador de permutaciones válidas encontradas.
+ * @param tiempoInicio Tiempo de inicio de la ejecución.
+ * @param M Tiempo máximo de ejecución en minutos.
+ */
+void encontrarPermutaciones(int posicionActual, int N, int arregloNumeros[], int numerosUsados[], int diferenciasUsadas[], unsigned long *totalPermutaciones, clock_t tiempoInicio, int M);
+
+/**
+ * @brief Inicializa un estado de búsqueda vacío.
+ *
+ * Con `simetria` activa solo se recorren representantes de cada clase
+ * {p, reverso, complemento, reverso del complemento}. La diferencia N-1 solo
+ * sale del par (1, N), así que 1 y N siempre son vecinos. Si el 1 está en la
+ * posición i, el complemento deja el par en la misma posición con el orden
+ * invertido y el reverso lo lleva a la posición N-2-i. El representante
+ * tiene el 1 justo antes del N y i < N-2-i, y cuenta por 4. Si i = N-2-i
+ * (N par), la permutación y su reverso-complemento cumplen ambas condiciones
+ * y cada una cuenta por 2; esto también es exacto cuando la permutación es
+ * igual a su reverso-complemento, porque su clase tiene solo 2 elementos.
+ *
+ * @param b Estado a inicializar.
+ * @param parametros Parámetros de la búsqueda.
+ */
+void iniciarBusquedaBits(busquedaBits_t *b, const parametrosBusqueda_t *parametros);
+
+/**
+ * @brief Reemplaza la permutación parcial del estado por los valores dados.
+ *
+ * Los contadores del estado no se modifican.
+ *
+ * @param b Estado de la búsqueda.
+ * @param prefijo Valores de las primeras posiciones.
+ * @param longitud Número de posiciones a fijar (puede ser 0).
+ */
+void fijarPrefijo(busquedaBits_t *b, const int *prefijo, int longitud);
+
+/**
+ * @brief Reemplaza la permutación parcial del estado por un prefijo.
+ *
+ * Los contadores del estado no se modifican.
+ *
+ * @param b Estado de la búsqueda.
+ * @param tarea Prefijo a aplicar.
+ */
+void aplicarPrefijo(busquedaBits_t *b, const tareaBusqueda_t *tarea);
+
+/**
+ * @brief Encuentra permutaciones gráciles usando conjuntos de bits (motor recursivo).
+ *
+ * @param b Estado de la búsqueda.
+ * @param posicionActual Posición actual en el arreglo de permutaciones.
+ */
+void encontrarPermutacionesBits(busquedaBits_t *b, int posicionActual);
+
+/**
+ * @brief Prepara el motor iterativo para explorar el subárbol de un prefijo.
+ *
+ * Las posiciones 0..base-1 ya deben estar fijadas. El nodo de la posición
+ * `base` no se cuenta aquí: lo cuenta quien lo creó.
+ *
+ * @param b Estado de la búsqueda.
+ * @param base Primera posición libre.
+ * @param candidatos Candidatos a probar en la posición `base`.
+ * @param peso Fracción del árbol completo que cubre la tarea (1 para la raíz).
+ */
+void iniciarTarea(busquedaBits_t *b, int base, uint64_t candidatos, double peso);
+
+/**
+ * @brief Avanza el motor iterativo hasta agotar un presupuesto de nodos.
+ *
+ * Al volver se cumple el invariante de la pila: las posiciones menores que
+ * `posicion` están colocadas y `pila[posicion]` tiene los candidatos que
+ * faltan por probar en ella. Así quien llama puede revisar el reloj, ceder
+ * trabajo o guardar el estado entre dos llamadas.
+ *
+ * @param b Estado de la búsqueda.
+ * @param presupuesto Nodos a visitar como máximo (se puede pasar por las hojas del último nivel).
+ * @return int 1 si la tarea tiene trabajo pendiente, 0 si terminó.
+ */
+int avanzarBusqueda(busquedaBits_t *b, unsigned long presupuesto);
+
+/**
+ * @brief Explora hasta el final, o hasta que se pida parar, la tarea preparada.
+ *
+ * Revisa la bandera de parada y el reloj cada PRESUPUESTO_REBANADA nodos.
+ *
+ * @param b Estado de la búsqueda, ya preparado con iniciarTarea().
+ */
+void completarTarea(busquedaBits_t *b);
+
+/**
+ * @brief Fracción que vale cada hermano pendiente de un nivel de la pila.
+ *
+ * @param b Estado de la búsqueda.
+ * @param nivel Posición entre `base` y `posicion`.
+ * @return double Parte del árbol completo bajo cada candidato del nivel.
+ */
+double pesoHermano(const busquedaBits_t *b, int nivel);
+
+/**
+ * @brief Fracción del árbol completo que ya exploró este estado.
+ *
+ * Suma las tareas terminadas y la parte recorrida de la tarea actual,
+ * calculada desde la pila. Es una estimación: supone que todos los hijos de
+ * un nodo tienen subárboles del mismo tamaño.
+ *
+ * @param b Estado de la búsqueda.
+ * @return double Valor entre 0 y 1.
+ */
+double fraccionExplorada(const busquedaBits_t *b);
+
+/**
+ * @brief Convierte el trabajo pendiente de la pila en tareas independientes.
+ *
+ * Cada nivel de la pila con hermanos sin probar da una tarea con el prefijo
+ * que los precede; el hijo en curso de cada nivel queda cubierto por los
+ * niveles más profundos. Las tareas cubren exactamente lo que le falta a la
+ * tarea actual, y sus pesos suman lo que le falta a fraccionExplorada().
+ *
+ * @param b Estado de la búsqueda, detenido entre dos rebanadas.
+ * @param tareas Arreglo de salida, con espacio para N tareas.
+ * @return int Número de tareas escritas (0 si la tarea actual terminó).
+ */
+int extraerPendientes(const busquedaBits_t *b, tareaBusqueda_t *tareas);
+
+/**
+ * @brief Genera todos los prefijos válidos de una longitud dada.
+ *
+ * Cada prefijo es un subproblema independiente: la suma de las búsquedas
+ * que parten de todos ellos es igual a la búsqueda completa. Los prefijos
+ * sin candidatos no generan tarea. Con longitud 0 se obtiene una sola tarea
+ * con el árbol completo.
+ *
+ * @param parametros Parámetros de la búsqueda.
+ * @param longitud Posiciones a fijar (0..N-1).
+ * @param tareas Arreglo de salida, con espacio para N^longitud tareas.
+ * @param nodos Se le suman los nodos recorridos, incluidos los de los prefijos.
+ * @return int Número de tareas generadas.
+ */
+int generarPrefijos(const parametrosBusqueda_t *parametros, int longitud, tareaBusqueda_t *tareas, unsigned long *nodos);
+
+/**
+ * @brief Genera los prefijos de una longitud que le tocan a un fragmento.
+ *
+ * Los prefijos de la longitud pedida, en el orden del recorrido (incluidos
+ * los que no tienen salida), se reparten por turnos: el prefijo número j es
+ * del fragmento j mod `fragmentos`. Así el reparto depende solo de N, de la
+ * simetría, de la longitud y del número de fragmentos. Cada fragmento
+ * cuenta los nodos de sus prefijos y el primero además los nodos internos,
+ * de modo que la suma de los fragmentos da los nodos de la búsqueda completa.
+ *
+ * @param parametros Parámetros de la búsqueda.
+ * @param longitud Posiciones a fijar (0..N-1).
+ * @param fragmento Fragmento a generar (0..fragmentos-1).
+ * @param fragmentos Número de fragmentos.
+ * @param tareas Arreglo de salida, con espacio para las tareas del fragmento.
+ * @param nodos Se le suman los nodos contados por el fragmento, o NULL.
+ * @param peso Recibe la fracción del árbol que cubre el fragmento, o NULL.
+ * @return int Número de tareas generadas.
+ */
+int generarFragmento(const parametrosBusqueda_t *parametros, int longitud, int fragmento, int fragmentos, tareaBusqueda_t *tareas, unsigned long *nodos, double *peso);
+
+/**
+ * @brief Cuenta los prefijos válidos de una longitud, incluidos los que no tienen salida.
+ *
+ * @param parametros Parámetros de la búsqueda.
+ * @param longitud Posiciones a fijar (0..N-1).
+ * @return unsigned long Número de prefijos.
+ */
+unsigned long contarPrefijos(const parametrosBusqueda_t *parametros, int longitud);
+
+#endif
@@ -0,0 +1,43 @@
+/**
+ * @file cancelacion.c
+ * @brief Implementación del tiempo límite y la cancelación cooperativa.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#include <time.h>
+
+#include "cancelacion.h"
+
+double relojMonotonico(void) {
+    struct timespec ahora;
+    clock_gettime(CLOCK_MONOTONIC, &ahora);
+    return (double)ahora.tv_sec + ahora.tv_nsec * 1e-9;
+}
+
+void iniciarCancelacion(cancelacion_t *c, double segundos) {
+    c->inicio = relojMonotonico();
+    c->plazo = c->inicio + segundos;
+    atomic_init(&c->detener, 0);
+}
+
+double tiempoTranscurrido(const cancelacion_t *c) {
+    return relojMonotonico() - c->inicio;
+}
+
+void solicitarParada(cancelacion_t *c) {
+    atomic_store_explicit(&c->detener, 1, memory_order_relaxed);
+}
+
+int revisarPlazo(cancelacion_t *c) {
+    if (paradaSolicitada(c)) {
+        return 1;
+    }
+    if (relojMonotonico() >= c->plazo) {
+        solicitarParada(c);
+        return 1;
+    }
+    return 0;
+}
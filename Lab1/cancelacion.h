@@ -0,0 +1,81 @@
+/**
+ * @file cancelacion.h
+ * @brief Tiempo límite y cancelación cooperativa de la búsqueda.
+ *
+ * El tiempo límite se mide con un reloj monotónico de pared (no con tiempo
+ * de CPU, que con varios hilos avanza más rápido que el reloj). Los motores
+ * consultan el reloj solo cada varios miles de nodos; el primer hilo que ve
+ * el plazo vencido enciende una bandera compartida que todos los demás
+ * revisan entre rebanadas de trabajo.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#ifndef CANCELACION_H
+#define CANCELACION_H
+
+#include <stdatomic.h>
+
+/**
+ * @brief Plazo y bandera de parada compartidos por todos los hilos.
+ */
+typedef struct {
+    double inicio;          ///< Instante de inicio (segundos del reloj monotónico).
+    double plazo;           ///< Instante en que se debe detener la búsqueda.
+    atomic_int detener;     ///< Distinto de cero cuando todos deben parar.
+} cancelacion_t;
+
+/**
+ * @brief Lee el reloj monotónico del sistema.
+ *
+ * @return double Segundos desde un origen arbitrario fijo.
+ */
+double relojMonotonico(void);
+
+/**
+ * @brief Arranca el reloj de una búsqueda.
+ *
+ * @param c Cancelación a inicializar.
+ * @param segundos Duración máxima de la búsqueda.
+ */
+void iniciarCancelacion(cancelacion_t *c, double segundos);
+
+/**
+ * @brief Segundos transcurridos desde iniciarCancelacion().
+ *
+ * @param c Cancelación de la búsqueda.
+ * @return double Tiempo de pared transcurrido.
+ */
+double tiempoTranscurrido(const cancelacion_t *c);
+
+/**
+ * @brief Pide a todos los hilos que se detengan.
+ *
+ * Solo hace una escritura atómica, así que se puede llamar desde un
+ * manejador de señales.
+ *
+ * @param c Cancelación de la búsqueda.
+ */
+void solicitarParada(cancelacion_t *c);
+
+/**
+ * @brief Revisa la bandera de parada sin consultar el reloj.
+ *
+ * @param c Cancelación de la búsqueda.
+ * @return int Distinto de cero si hay que detenerse.
+ */
+static inline int paradaSolicitada(cancelacion_t *c) {
+    return atomic_load_explicit(&c->detener, memory_order_relaxed);
+}
+
+/**
+ * @brief Revisa la bandera y el reloj; si el plazo venció, enciende la bandera.
+ *
+ * @param c Cancelación de la búsqueda.
+ * @return int Distinto de cero si hay que detenerse.
+ */
+int revisarPlazo(cancelacion_t *c);
+
+#endif
@@ -0,0 +1,151 @@
+/**
+ * @file estimacion.c
+ * @brief Sondas aleatorias de Knuth y calibración de la velocidad.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#include <math.h>
+
+#include "estimacion.h"
+
+#define SONDAS_POR_CHEQUEO 64 ///< Sondas entre dos consultas del reloj.
+/**
+ * @brief Posiciones finales que cada sonda recorre completas en lugar de al azar.
+ *
+ * Cerca de las hojas el árbol es angosto y casi todas las ramas mueren, así
+ * que una sonda puramente aleatoria casi nunca llega a una permutación y la
+ * estimación de permutaciones tiene una varianza enorme. Recorrer estos
+ * subárboles pequeños con el motor iterativo la reduce mucho.
+ */
+#define RESTANTES_EXACTOS 8
+
+/**
+ * @brief Media y varianza acumuladas con el método de Welford.
+ */
+typedef struct {
+    unsigned long n;    ///< Muestras acumuladas.
+    double media;       ///< Media de las muestras.
+    double m2;          ///< Suma de cuadrados de las desviaciones.
+} acumulador_t;
+
+static void acumular(acumulador_t *a, double x) {
+    a->n++;
+    double delta = x - a->media;
+    a->media += delta / a->n;
+    a->m2 += delta * (x - a->media);
+}
+
+/** @brief Mitad del ancho del intervalo de confianza de la media. */
+static double errorMedia(const acumulador_t *a) {
+    if (a->n < 2) {
+        return INFINITY;
+    }
+    return Z_CONFIANZA * sqrt(a->m2 / (a->n - 1) / a->n);
+}
+
+/** @brief Generador xorshift64*: rápido y suficiente para elegir hijos. */
+static uint64_t siguienteAleatorio(uint64_t *estado) {
+    *estado ^= *estado >> 12;
+    *estado ^= *estado << 25;
+    *estado ^= *estado >> 27;
+    return *estado * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief Baja de la raíz a una hoja eligiendo hijos al azar.
+ *
+ * @param b Estado de la búsqueda; se reemplaza su permutación parcial.
+ * @param aleatorio Estado del generador.
+ * @param permutaciones Estimación de las permutaciones que da la sonda.
+ * @return double Estimación de los nodos que da la sonda.
+ */
+static double sondear(busquedaBits_t *b, uint64_t *aleatorio, double *permutaciones) {
+    double factor = 1;  // Nodos estimados en el nivel actual
+    double nodos = 1;   // La raiz, como en main
+    fijarPrefijo(b, NULL, 0);
+    *permutaciones = 0;
+
+    for (int posicion = 0; posicion < b->N; posicion++) {
+        uint64_t candidatos = candidatosBits(b, posicion);
+        if (posicion > 0 && posicion >= b->N - RESTANTES_EXACTOS) {
+            // Los ultimos niveles se recorren completos: casi no cuesta y quita mucha varianza
+            b->nodos = 0;
+            b->totalPermutaciones = 0;
+            iniciarTarea(b, posicion, candidatos, 1.0);
+            while (avanzarBusqueda(b, PRESUPUESTO_REBANADA)) {
+            }
+            nodos += factor * b->nodos;
+            *permutaciones = factor * b->totalPermutaciones;
+            break;
+        }
+        int hijos = __builtin_popcountll(candidatos);
+        if (hijos == 0) {
+            break;  // Rama sin salida: no aporta permutaciones
+        }
+        factor *= hijos;
+        nodos += factor;
+        if (posicion == b->N - 1) {
+            *permutaciones = factor * pesoHoja(b);
+            break;
+        }
+
+        // Hijo al azar, todos con la misma probabilidad
+        int elegido = (int)(((siguienteAleatorio(aleatorio) >> 32) * (uint64_t)hijos) >> 32);
+        while (elegido-- > 0) {
+            candidatos &= candidatos - 1;
+        }
+        alternarNumero(b, posicion, __builtin_ctzll(candidatos));
+    }
+    return nodos;
+}
+
+void estimarArbol(const parametrosBusqueda_t *parametros, estimacionArbol_t *estimacion) {
+    cancelacion_t plazo;
+    parametrosBusqueda_t propios = *parametros;
+    propios.cancelacion = &plazo;
+    propios.tabla = NULL;
+    propios.salida = NULL;
+    busquedaBits_t b;
+
+    // Velocidad: recorrer el arbol de verdad durante un momento
+    iniciarCancelacion(&plazo, SEGUNDOS_CALIBRACION);
+    iniciarBusquedaBits(&b, &propios);
+    b.nodos++;  // La raiz
+    iniciarTarea(&b, 0, candidatosBits(&b, 0), 1.0);
+    completarTarea(&b);
+    double segundos = tiempoTranscurrido(&plazo);
+    estimacion->nodosPorSegundo = segundos > 0 ? b.nodos / segundos : 0;
+    estimacion->sondas = 0;
+    if (!b.tiempoAgotado) {
+        // Arbol pequeno: ya se conoce exacto
+        estimacion->exacto = 1;
+        estimacion->nodos = b.nodos;
+        estimacion->permutaciones = b.totalPermutaciones;
+        estimacion->errorNodos = 0;
+        estimacion->errorPermutaciones = 0;
+        return;
+    }
+    estimacion->exacto = 0;
+
+    // Sondas aleatorias hasta agotar el tiempo
+    acumulador_t nodos = {0, 0, 0};
+    acumulador_t permutaciones = {0, 0, 0};
+    uint64_t aleatorio = (uint64_t)(relojMonotonico() * 1e9) | 1;
+    iniciarCancelacion(&plazo, SEGUNDOS_SONDEO);
+    do {
+        for (int i = 0; i < SONDAS_POR_CHEQUEO; i++) {
+            double permutacionesSonda;
+            acumular(&nodos, sondear(&b, &aleatorio, &permutacionesSonda));
+            acumular(&permutaciones, permutacionesSonda);
+        }
+    } while (!revisarPlazo(&plazo));
+
+    estimacion->sondas = nodos.n;
+    estimacion->nodos = nodos.media;
+    estimacion->errorNodos = errorMedia(&nodos);
+    estimacion->permutaciones = permutaciones.media;
+    estimacion->errorPermutaciones = errorMedia(&permutaciones);
+}
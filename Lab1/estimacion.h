@@ -0,0 +1,56 @@
+/**
+ * @file estimacion.h
+ * @brief Estimación del tamaño del árbol de búsqueda antes de recorrerlo.
+ *
+ * Usa el método de Knuth: una sonda baja de la raíz a una hoja eligiendo en
+ * cada nivel un hijo al azar, y multiplica los números de hijos de los
+ * niveles que atraviesa. El producto acumulado en cada nivel es un
+ * estimador insesgado de los nodos de ese nivel, y el del último nivel (por
+ * el peso de las hojas) lo es de las permutaciones gráciles. El promedio de
+ * muchas sondas da la estimación y su dispersión da el intervalo de
+ * confianza.
+ *
+ * El tiempo se estima con la velocidad del motor iterativo medida en la
+ * misma máquina, recorriendo de verdad el árbol durante un momento.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#ifndef ESTIMACION_H
+#define ESTIMACION_H
+
+#include "busqueda.h"
+
+#define SEGUNDOS_CALIBRACION 1.0 ///< Tiempo recorriendo el árbol para medir la velocidad.
+#define SEGUNDOS_SONDEO 2.0      ///< Tiempo lanzando sondas aleatorias.
+#define Z_CONFIANZA 1.96         ///< Cuantil normal del intervalo de confianza del 95%.
+
+/**
+ * @brief Resultado de una estimación.
+ *
+ * Los errores son la mitad del ancho del intervalo de confianza del 95%.
+ */
+typedef struct {
+    unsigned long sondas;       ///< Sondas lanzadas.
+    double nodos;               ///< Nodos estimados del árbol.
+    double errorNodos;          ///< Error de `nodos`.
+    double permutaciones;       ///< Permutaciones gráciles estimadas.
+    double errorPermutaciones;  ///< Error de `permutaciones`.
+    double nodosPorSegundo;     ///< Velocidad medida de un hilo.
+    int exacto;                 ///< 1 si la calibración alcanzó a recorrer todo el árbol.
+} estimacionArbol_t;
+
+/**
+ * @brief Estima nodos, permutaciones y velocidad para unos parámetros.
+ *
+ * Tarda unos SEGUNDOS_CALIBRACION + SEGUNDOS_SONDEO segundos. La tabla de
+ * transposición de los parámetros no se usa.
+ *
+ * @param parametros Parámetros de la búsqueda a estimar.
+ * @param estimacion Resultado.
+ */
+void estimarArbol(const parametrosBusqueda_t *parametros, estimacionArbol_t *estimacion);
+
+#endif // ESTIMACION_H
@@ -0,0 +1,167 @@
+/**
+ * @file fragmentos.c
+ * @brief Implementación del reparto en fragmentos y de la suma de sus resultados.
+ *
+ * El archivo de resultado es de texto, una clave y su valor por línea, para
+ * poder revisarlo a mano en el clúster:
+ * @code
+ * graciles-fragmento 2
+ * N 20
+ * simetria 0
+ * propagacion 1
+ * fragmento 3 8
+ * permutaciones 123456
+ * nodos 7890123
+ * completo 1
+ * @endcode
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fragmentos.h"
+
+#define VERSION_FRAGMENTO 2
+
+int longitudFragmentos(const parametrosBusqueda_t *parametros, int fragmentos) {
+    unsigned long objetivo = (unsigned long)fragmentos * PREFIJOS_POR_FRAGMENTO;
+    int maxima = parametros->N - 1;
+    if (maxima > LONGITUD_FRAGMENTO_MAXIMA) {
+        maxima = LONGITUD_FRAGMENTO_MAXIMA;
+    }
+    for (int longitud = 1; longitud < maxima; longitud++) {
+        if (contarPrefijos(parametros, longitud) >= objetivo) {
+            return longitud;
+        }
+    }
+    return maxima;
+}
+
+int leerFragmento(const char *texto, int *fragmento, int *fragmentos) {
+    char resto;
+    if (sscanf(texto, "%d/%d%c", fragmento, fragmentos, &resto) != 2) {
+        return -1;
+    }
+    if (*fragmentos < 1 || *fragmentos > MAX_FRAGMENTOS || *fragmento < 0 || *fragmento >= *fragmentos) {
+        return -1;
+    }
+    return 0;
+}
+
+int guardarResultadoFragmento(const char *archivo, const resultadoFragmento_t *r) {
+    FILE *f = fopen(archivo, "w");
+    if (f == NULL) {
+        return -1;
+    }
+    fprintf(f, "graciles-fragmento %d\n", VERSION_FRAGMENTO);
+    fprintf(f, "N %d\n", r->N);
+    fprintf(f, "simetria %d\n", r->simetria);
+    fprintf(f, "propagacion %d\n", r->propagacion);
+    fprintf(f, "fragmento %d %d\n", r->fragmento, r->fragmentos);
+    fprintf(f, "permutaciones %lu\n", r->totalPermutaciones);
+    fprintf(f, "nodos %lu\n", r->nodos);
+    fprintf(f, "completo %d\n", r->completo);
+    int error = ferror(f);
+    if (fclose(f) != 0) {
+        error = 1;
+    }
+    return error ? -1 : 0;
+}
+
+// Lee un archivo de resultado; devuelve 0 si tiene el formato esperado
+static int cargarResultadoFragmento(const char *archivo, resultadoFragmento_t *r) {
+    FILE *f = fopen(archivo, "r");
+    if (f == NULL) {
+        return -1;
+    }
+    int version;
+    int leidos = fscanf(f, " graciles-fragmento %d N %d simetria %d propagacion %d fragmento %d %d "
+                        "permutaciones %lu nodos %lu completo %d",
+                        &version, &r->N, &r->simetria, &r->propagacion, &r->fragmento, &r->fragmentos,
+                        &r->totalPermutaciones, &r->nodos, &r->completo);
+    fclose(f);
+    if (leidos != 9 || version != VERSION_FRAGMENTO) {
+        return -1;
+    }
+    if (r->fragmentos < 1 || r->fragmentos > MAX_FRAGMENTOS || r->fragmento < 0 || r->fragmento >= r->fragmentos) {
+        return -1;
+    }
+    return 0;
+}
+
+int combinarFragmentos(char *const archivos[], int numArchivos) {
+    if (numArchivos == 0) {
+        printf("No se indicaron archivos de resultado\n");
+        return 1;
+    }
+
+    resultadoFragmento_t primero = {0};
+    const char **origen = NULL;   // Archivo de cada fragmento, NULL si falta
+    unsigned long totalPermutaciones = 0;
+    unsigned long nodos = 0;
+    int errores = 0;
+
+    for (int i = 0; i < numArchivos; i++) {
+        resultadoFragmento_t r;
+        if (cargarResultadoFragmento(archivos[i], &r) != 0) {
+            printf("[ERROR] No se pudo leer el resultado %s\n", archivos[i]);
+            errores++;
+            continue;
+        }
+        if (origen == NULL) {
+            primero = r;
+            origen = calloc((size_t)r.fragmentos, sizeof(const char *));
+            if (origen == NULL) {
+                printf("No hay memoria para combinar %d fragmentos\n", r.fragmentos);
+                return 1;
+            }
+        } else if (r.N != primero.N || r.simetria != primero.simetria || r.propagacion != primero.propagacion ||
+                   r.fragmentos != primero.fragmentos) {
+            printf("[ERROR] %s es de otra busqueda (N = %d, %d fragmentos, simetria %d, propagacion %d)\n",
+                   archivos[i], r.N, r.fragmentos, r.simetria, r.propagacion);
+            errores++;
+            continue;
+        }
+        if (origen[r.fragmento] != NULL) {
+            printf("[ERROR] El fragmento %d esta repetido en %s y %s\n", r.fragmento, origen[r.fragmento], archivos[i]);
+            errores++;
+            continue;
+        }
+        if (!r.completo) {
+            printf("[ERROR] El fragmento %d (%s) no se termino de contar\n", r.fragmento, archivos[i]);
+            errores++;
+        }
+        origen[r.fragmento] = archivos[i];
+        totalPermutaciones += r.totalPermutaciones;
+        nodos += r.nodos;
+    }
+    if (origen == NULL) {
+        return 1;
+    }
+
+    int presentes = 0;
+    for (int i = 0; i < primero.fragmentos; i++) {
+        if (origen[i] != NULL) {
+            presentes++;
+        } else {
+            printf("[ERROR] Falta el fragmento %d/%d\n", i, primero.fragmentos);
+            errores++;
+        }
+    }
+    free(origen);
+
+    printf("Cantidad de numeros ingresada: %d\n", primero.N);
+    printf("Fragmentos combinados: %d de %d\n", presentes, primero.fragmentos);
+    if (errores > 0) {
+        printf("[AVISO] Conteo incompleto; suma de los fragmentos validos: %lu\n", totalPermutaciones);
+        return 1;
+    }
+    printf("Numero total de permutaciones graciles: %lu\n", totalPermutaciones);
+    printf("Nodos explorados: %lu\n", nodos);
+    return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file fragmentos.h
+ * @brief División de una búsqueda en fragmentos para procesos independientes.
+ *
+ * Con `--shard i/k` cada proceso cuenta solo los prefijos que le tocan, sin
+ * memoria compartida con los demás, y escribe un archivo de resultado
+ * pequeño. Después `--merge` suma los archivos y verifica que estén todos
+ * los fragmentos, completos y de la misma búsqueda.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#ifndef FRAGMENTOS_H
+#define FRAGMENTOS_H
+
+#include "busqueda.h"
+
+#define MAX_FRAGMENTOS 65536          ///< Máximo número de fragmentos.
+#define PREFIJOS_POR_FRAGMENTO 16     ///< Prefijos mínimos por fragmento, para repartir la carga.
+#define LONGITUD_FRAGMENTO_MAXIMA 8   ///< Posiciones fijadas como máximo para repartir.
+
+/**
+ * @brief Resultado de un fragmento, tal como queda en su archivo.
+ */
+typedef struct {
+    int N;                            ///< Tamaño del conjunto de números.
+    int simetria;                     ///< 1 si se contaron solo representantes canónicos.
+    int propagacion;                  ///< 1 si se podó con las diferencias grandes (cambia el reparto).
+    int fragmento;                    ///< Fragmento contado (0..fragmentos-1).
+    int fragmentos;                   ///< Número total de fragmentos.
+    unsigned long totalPermutaciones; ///< Permutaciones del fragmento.
+    unsigned long nodos;              ///< Nodos del fragmento.
+    int completo;                     ///< 1 si el fragmento se terminó de contar.
+} resultadoFragmento_t;
+
+/**
+ * @brief Elige cuántas posiciones fijar para repartir prefijos entre fragmentos.
+ *
+ * Usa la menor longitud que da al menos PREFIJOS_POR_FRAGMENTO prefijos por
+ * fragmento. Solo depende de N, de la simetría, de la poda por diferencias
+ * grandes y del número de fragmentos, así todos los procesos con las mismas
+ * opciones llegan al mismo reparto.
+ *
+ * @param parametros Parámetros de la búsqueda.
+ * @param fragmentos Número de fragmentos.
+ * @return int Longitud de los prefijos (0..N-1).
+ */
+int longitudFragmentos(const parametrosBusqueda_t *parametros, int fragmentos);
+
+/**
+ * @brief Lee "i/k" de la línea de comandos.
+ *
+ * @param texto Texto con el formato i/k, 0 <= i < k <= MAX_FRAGMENTOS.
+ * @param fragmento Recibe i.
+ * @param fragmentos Recibe k.
+ * @return int 0 si el formato es válido, -1 si no.
+ */
+int leerFragmento(const char *texto, int *fragmento, int *fragmentos);
+
+/**
+ * @brief Escribe el archivo de resultado de un fragmento.
+ *
+ * @param archivo Ruta del archivo.
+ * @param r Resultado a guardar.
+ * @return int 0 si se guardó, -1 si no.
+ */
+int guardarResultadoFragmento(const char *archivo, const resultadoFragmento_t *r);
+
+/**
+ * @brief Suma los archivos de resultado de todos los fragmentos y muestra el total.
+ *
+ * Falla si algún archivo no se puede leer, si no son de la misma búsqueda,
+ * si hay fragmentos repetidos, faltantes o sin terminar.
+ *
+ * @param archivos Rutas de los archivos de resultado.
+ * @param numArchivos Número de archivos.
+ * @return int 0 si el total es válido, 1 si no.
+ */
+int combinarFragmentos(char *const archivos[], int numArchivos);
+
+#endif
@@ -0,0 +1,107 @@
+/**
+ * @file generador.c
+ * @brief Implementación del generador perezoso de permutaciones gráciles.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#include <string.h>
+
+#include "generador.h"
+
+int crearGenerador(generadorGracil_t *g, int N, const int *prefijo, int longitud) {
+    if (N < 2 || N > N_MAXIMO || longitud < 0 || longitud >= N) {
+        return -1;
+    }
+    parametrosBusqueda_t parametros;
+    memset(&parametros, 0, sizeof(parametros));
+    parametros.N = N;
+    iniciarBusquedaBits(&g->b, &parametros);
+
+    // Colocar el prefijo revisando cada numero como lo haria la busqueda; sin
+    // propagacion, para que un prefijo valido sin permutaciones no sea un error
+    int revisar = g->b.diferenciasPropagadas;
+    g->b.diferenciasPropagadas = 0;
+    for (int p = 0; p < longitud; p++) {
+        if (prefijo[p] < 1 || prefijo[p] > N || !(candidatosBits(&g->b, p) & (1ULL << prefijo[p]))) {
+            return -1;
+        }
+        alternarNumero(&g->b, p, prefijo[p]);
+    }
+    g->b.diferenciasPropagadas = revisar;
+
+    g->base = longitud;
+    g->colocada = 0;
+    g->hojas = 0;
+    if (longitud == N - 1) {
+        // Solo falta la ultima posicion: sus candidatos son todas las hojas
+        g->hojas = candidatosBits(&g->b, longitud);
+        g->posicion = longitud - 1;
+    } else {
+        g->b.pila[longitud] = candidatosBits(&g->b, longitud);
+        g->posicion = longitud;
+    }
+    return 0;
+}
+
+int siguienteGracil(generadorGracil_t *g, int *permutacion) {
+    busquedaBits_t *b = &g->b;
+    int ultima = b->N - 1;
+
+    for (;;) {
+        if (g->hojas) {
+            memcpy(permutacion, b->arregloNumeros, (size_t)ultima * sizeof(int));
+            permutacion[ultima] = __builtin_ctzll(g->hojas);
+            g->hojas &= g->hojas - 1;
+            return 1;
+        }
+        if (g->colocada) {
+            // Sin mas hojas: quitar la penultima posicion y seguir con sus hermanos
+            alternarNumero(b, g->posicion, b->arregloNumeros[g->posicion]);
+            g->colocada = 0;
+        }
+        if (g->posicion < g->base) {
+            return 0;
+        }
+
+        uint64_t pendientes = b->pila[g->posicion];
+        if (pendientes == 0) {
+            // Se agotaron los hermanos: volver al nivel anterior
+            if (--g->posicion >= g->base) {
+                alternarNumero(b, g->posicion, b->arregloNumeros[g->posicion]);
+            }
+            continue;
+        }
+        int numeroIntento = __builtin_ctzll(pendientes);
+        b->pila[g->posicion] = pendientes & (pendientes - 1);
+        alternarNumero(b, g->posicion, numeroIntento);
+
+        uint64_t siguientes = candidatosBits(b, g->posicion + 1);
+        if (g->posicion + 1 == ultima) {
+            g->hojas = siguientes;
+            g->colocada = 1;
+        } else {
+            b->pila[++g->posicion] = siguientes;
+        }
+    }
+}
+
+void saltarPrefijo(generadorGracil_t *g, int longitud) {
+    if (longitud >= g->b.N) {
+        return;  // Cualquier otra permutacion ya difiere en algun numero
+    }
+    // Las hojas son la posicion N-1, que siempre queda dentro del inicio descartado
+    g->hojas = 0;
+    if (longitud <= g->base) {
+        // Todo el generador comparte ese inicio
+        g->posicion = g->base - 1;
+        g->colocada = 0;
+        return;
+    }
+    // Vaciar los candidatos de los niveles desde `longitud`; la busqueda vuelve sola
+    for (int p = longitud; p <= g->posicion; p++) {
+        g->b.pila[p] = 0;
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * @file generador.h
+ * @brief Generador perezoso de permutaciones gráciles para usar como biblioteca.
+ *
+ * Alternativa a contar desde main(): quien lo usa pide las permutaciones
+ * una por una con siguienteGracil(). Cada llamada avanza la búsqueda con
+ * pila explícita justo hasta la siguiente hoja y se detiene ahí, sin
+ * guardar soluciones en ningún búfer, así que pedir solo las primeras k
+ * cuesta solo lo que se recorre hasta encontrarlas. Las permutaciones salen
+ * en orden lexicográfico.
+ *
+ * Ejemplo: las permutaciones de 10 que empiezan con 1, 10:
+ * @code
+ * generadorGracil_t g;
+ * int prefijo[2] = {1, 10};
+ * int p[10];
+ * if (crearGenerador(&g, 10, prefijo, 2) == 0) {
+ *     while (siguienteGracil(&g, p)) {
+ *         // usar p; saltarPrefijo(&g, 3) descarta las demás que empiezan con p[0..2]
+ *     }
+ * }
+ * @endcode
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#ifndef GENERADOR_H
+#define GENERADOR_H
+
+#include "busqueda.h"
+
+/**
+ * @brief Estado del generador: la búsqueda detenida en una hoja.
+ *
+ * Las posiciones 0..posicion están colocadas si `colocada` vale 1 (con los
+ * candidatos de la última posición en `hojas`); si no, están colocadas
+ * 0..posicion-1 y `b.pila[posicion]` tiene los candidatos por probar.
+ */
+typedef struct {
+    busquedaBits_t b;   ///< Máscaras, permutación parcial y pila de candidatos.
+    int base;           ///< Posiciones fijadas por el prefijo.
+    int posicion;       ///< Nivel actual de la pila; menor que `base` al terminar.
+    int colocada;       ///< 1 si la penúltima posición está colocada y quedan hojas por dar.
+    uint64_t hojas;     ///< Candidatos de la última posición que faltan por dar.
+} generadorGracil_t;
+
+/**
+ * @brief Prepara un generador para las permutaciones que empiezan con un prefijo.
+ *
+ * @param g Generador a inicializar.
+ * @param N Tamaño del conjunto de números (2..N_MAXIMO).
+ * @param prefijo Primeros números de las permutaciones, o NULL.
+ * @param longitud Números del prefijo (0..N-1).
+ * @return int 0 si se pudo crear, -1 si N o el prefijo no son válidos.
+ */
+int crearGenerador(generadorGracil_t *g, int N, const int *prefijo, int longitud);
+
+/**
+ * @brief Avanza hasta la siguiente permutación grácil.
+ *
+ * @param g Generador.
+ * @param permutacion Donde se copian los N números de la permutación.
+ * @return int 1 si había otra permutación, 0 si ya no quedan.
+ */
+int siguienteGracil(generadorGracil_t *g, int *permutacion);
+
+/**
+ * @brief Descarta las permutaciones que faltan con el mismo inicio que la última.
+ *
+ * Después de esta llamada, siguienteGracil() da la primera permutación cuyos
+ * primeros `longitud` números difieren de los de la última que dio. Sirve
+ * para podar desde afuera cuando un inicio no interesa.
+ *
+ * @param g Generador que ya dio al menos una permutación.
+ * @param longitud Números del inicio a descartar (1..N; con N no hace nada).
+ * Con un valor menor o igual que el prefijo del generador ya no quedan
+ * permutaciones.
+ */
+void saltarPrefijo(generadorGracil_t *g, int longitud);
+
+#endif // GENERADOR_H
@@ -0,0 +1,86 @@
+/**
+ * @file hilos.c
+ * @brief Implementación de la búsqueda paralela por prefijos.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "busqueda.h"
+#include "fragmentos.h"
+#include "hilos.h"
+#include "robo.h"
+
+int buscarEnParalelo(const parametrosBusqueda_t *parametros, const configEjecutor_t *config, resultadoBusqueda_t *resultado, estadisticaHilo_t *porHilo) {
+    int N = parametros->N;
+    int longitud;
+    size_t maxTareas;
+    if (config->fragmentos > 1) {
+        // El reparto entre fragmentos no depende del numero de hilos
+        longitud = longitudFragmentos(parametros, config->fragmentos);
+        maxTareas = contarPrefijos(parametros, longitud) / config->fragmentos + 1;
+    } else if (config->robar) {
+        longitud = 0;  // Con robo de trabajo basta la raiz
+        maxTareas = 1;
+    } else {
+        // Fijar dos posiciones da N*(N-1) tareas, suficientes para repartir
+        longitud = (N > LONGITUD_PREFIJO_MAXIMA) ? LONGITUD_PREFIJO_MAXIMA : N - 1;
+        maxTareas = (size_t)N * N;
+    }
+
+    tareaBusqueda_t *tareas = malloc(maxTareas * sizeof(tareaBusqueda_t));
+    if (tareas == NULL) {
+        return -1;
+    }
+
+    // Los prefijos sin salida ya quedaron explorados al generarlos
+    memset(resultado, 0, sizeof(*resultado));
+    int numTareas = generarFragmento(parametros, longitud, config->fragmento, config->fragmentos,
+                                     tareas, &resultado->nodos, &resultado->pesoFragmento);
+    resultado->fraccionExplorada = resultado->pesoFragmento;
+    for (int i = 0; i < numTareas; i++) {
+        resultado->fraccionExplorada -= tareas[i].peso;
+    }
+
+    int exito = ejecutarTareas(parametros, config, tareas, numTareas, resultado, porHilo);
+    free(tareas);
+    return exito;
+}
+
+int buscarRango(const parametrosBusqueda_t *parametros, int desde, int hasta, const configEjecutor_t *config, resultadoBusqueda_t *resultados, tiempoProblema_t *tiempos, estadisticaHilo_t *porHilo) {
+    int numProblemas = hasta - desde + 1;
+    parametrosBusqueda_t *porN = malloc((size_t)numProblemas * sizeof(parametrosBusqueda_t));
+    tareaBusqueda_t *tareas = malloc((size_t)numProblemas * sizeof(tareaBusqueda_t));
+    int *problemas = malloc((size_t)numProblemas * sizeof(int));
+    if (porN == NULL || tareas == NULL || problemas == NULL) {
+        free(porN);
+        free(tareas);
+        free(problemas);
+        return -1;
+    }
+
+    // Una tarea por N con su raiz, de la mas grande a la mas pequena
+    memset(resultados, 0, (size_t)numProblemas * sizeof(resultadoBusqueda_t));
+    int numTareas = 0;
+    for (int p = numProblemas - 1; p >= 0; p--) {
+        porN[p] = *parametros;
+        porN[p].N = desde + p;
+        if (generarFragmento(&porN[p], 0, 0, 1, &tareas[numTareas], &resultados[p].nodos,
+                             &resultados[p].pesoFragmento) > 0) {
+            problemas[numTareas++] = p;
+        }
+    }
+
+    configEjecutor_t configRango = *config;
+    configRango.robar = 1;
+    int exito = ejecutarProblemas(porN, numProblemas, &configRango, tareas, problemas, numTareas,
+                                  resultados, tiempos, porHilo);
+    free(porN);
+    free(tareas);
+    free(problemas);
+    return exito;
+}
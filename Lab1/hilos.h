@@ -0,0 +1,103 @@
+/**
+ * @file hilos.h
+ * @brief Búsqueda paralela de permutaciones gráciles por prefijos.
+ *
+ * El árbol de búsqueda se divide en subproblemas independientes fijando las
+ * primeras posiciones de la permutación. Un grupo de hilos toma esos
+ * subproblemas de una cola compartida y cada hilo resuelve los suyos con su
+ * propio estado de búsqueda. Con robo de trabajo la cola empieza con el
+ * árbol completo y los hilos ociosos le quitan trabajo a los ocupados.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#ifndef HILOS_H
+#define HILOS_H
+
+#include "busqueda.h"
+
+#define MAX_HILOS 256        ///< Máximo número de hilos de trabajo.
+#define TAM_LINEA_CACHE 64   ///< Tamaño de línea de caché, para separar contadores.
+#define INTERVALO_PROGRESO 5.0 ///< Segundos entre reportes de progreso por defecto.
+
+/**
+ * @brief Resultado acumulado de una búsqueda.
+ */
+typedef struct {
+    unsigned long totalPermutaciones; ///< Permutaciones gráciles encontradas.
+    unsigned long nodos;              ///< Nodos visitados del árbol de búsqueda.
+    int tiempoAgotado;                ///< 1 si la búsqueda se detuvo antes de terminar.
+    double fraccionExplorada;         ///< Parte estimada del árbol recorrida (0..1).
+    int errorPuntoControl;            ///< 1 si algún punto de control no se pudo guardar.
+    double pesoFragmento;             ///< Fracción del árbol asignada a esta búsqueda (1 sin --shard).
+    unsigned long consultasTabla;     ///< Consultas a la tabla de transposición.
+    unsigned long aciertosTabla;      ///< Subárboles que se tomaron de la tabla.
+} resultadoBusqueda_t;
+
+/**
+ * @brief Estadísticas de un hilo de trabajo, para ver el balance de carga.
+ */
+typedef struct {
+    unsigned long nodos;   ///< Nodos visitados por el hilo.
+    unsigned long tareas;  ///< Tareas (prefijos o trabajo robado) resueltas por el hilo.
+} estadisticaHilo_t;
+
+/**
+ * @brief Tiempos de un problema cuando varios comparten los hilos (ver buscarRango()).
+ */
+typedef struct {
+    double segundosHilos;  ///< Suma del tiempo que cada hilo dedicó al problema.
+    double terminado;      ///< Segundos desde el inicio hasta que terminó su última tarea.
+} tiempoProblema_t;
+
+/**
+ * @brief Configuración del ejecutor de tareas.
+ */
+typedef struct {
+    int hilos;                        ///< Número de hilos de trabajo (1..MAX_HILOS).
+    int robar;                        ///< 1 para que los hilos ociosos roben trabajo.
+    const char *archivoPuntoControl;  ///< Archivo donde guardar puntos de control, o NULL.
+    double intervaloPuntoControl;     ///< Segundos entre dos puntos de control.
+    int fragmento;                    ///< Fragmento que se cuenta (0..fragmentos-1).
+    int fragmentos;                   ///< Número de fragmentos (1 para el árbol completo).
+    double intervaloProgreso;         ///< Segundos entre dos reportes de progreso (0: sin reporte).
+    int progresoJson;                 ///< 1 para reportar el progreso como líneas JSON.
+} configEjecutor_t;
+
+/**
+ * @brief Busca permutaciones gráciles desde cero repartiendo el árbol entre varios hilos.
+ *
+ * Sin robo de trabajo la cola tiene los prefijos de longitud
+ * LONGITUD_PREFIJO_MAXIMA; con robo, solo la raíz. Con varios fragmentos
+ * la cola tiene solo los prefijos del fragmento pedido.
+ *
+ * @param parametros Parámetros de la búsqueda.
+ * @param config Hilos, modo de reparto y puntos de control.
+ * @param resultado Suma de los contadores de todos los hilos.
+ * @param porHilo Arreglo de `config->hilos` estadísticas a llenar, o NULL.
+ * @return int 0 si la búsqueda se pudo lanzar, -1 si no hubo memoria o hilos.
+ */
+int buscarEnParalelo(const parametrosBusqueda_t *parametros, const configEjecutor_t *config, resultadoBusqueda_t *resultado, estadisticaHilo_t *porHilo);
+
+/**
+ * @brief Cuenta todos los N de un rango con un solo grupo de hilos.
+ *
+ * La cola tiene la raíz de cada N, de la más grande a la más pequeña: los
+ * primeros hilos toman los árboles grandes, los demás resuelven los
+ * pequeños y luego roban trabajo de los grandes, así ningún hilo queda
+ * ocioso mientras falte algún N. Usa siempre robo de trabajo.
+ *
+ * @param parametros Parámetros comunes; su N se ignora.
+ * @param desde Menor N del rango.
+ * @param hasta Mayor N del rango.
+ * @param config Hilos de trabajo (sin puntos de control ni fragmentos).
+ * @param resultados Arreglo de `hasta - desde + 1` resultados, uno por N.
+ * @param tiempos Arreglo de `hasta - desde + 1` tiempos, uno por N.
+ * @param porHilo Arreglo de `config->hilos` estadísticas a llenar, o NULL.
+ * @return int 0 si la búsqueda se pudo lanzar, -1 si no hubo memoria o hilos.
+ */
+int buscarRango(const parametrosBusqueda_t *parametros, int desde, int hasta, const configEjecutor_t *config, resultadoBusqueda_t *resultados, tiempoProblema_t *tiempos, estadisticaHilo_t *porHilo);
+
+#endif
@@ -0,0 +1,157 @@
+/**
+ * @file hojas.c
+ * @brief Versiones escalar, AVX2 y AVX-512 del conteo de las dos últimas posiciones.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#include "hojas.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define HAY_SIMD_X86 1
+#endif
+
+unsigned long contarPenultimoEscalar(const nivelPenultimo_t *nivel, uint64_t candidatos) {
+    unsigned long hojas = 0;
+    while (candidatos) {
+        hojas += __builtin_popcountll(candidatosUltima(nivel, __builtin_ctzll(candidatos)));
+        candidatos &= candidatos - 1;
+    }
+    return hojas;
+}
+
+#ifdef HAY_SIMD_X86
+/**
+ * @brief Versión AVX2: cuatro hermanos por iteración.
+ *
+ * AVX2 tiene desplazamientos de 64 bits con una cantidad distinta por
+ * carril, que es justo lo que necesita cada hermano; el popcount se hace
+ * carril por carril.
+ */
+__attribute__((target("avx2,popcnt")))
+static unsigned long contarPenultimoAvx2(const nivelPenultimo_t *nivel, uint64_t candidatos) {
+    const __m256i uno = _mm256_set1_epi64x(1);
+    const __m256i sesentaYTres = _mm256_set1_epi64x(63);
+    const __m256i cero = _mm256_setzero_si256();
+    const __m256i anterior = _mm256_set1_epi64x(nivel->anterior);
+    const __m256i usadosAntes = _mm256_set1_epi64x((long long)nivel->numerosUsados);
+    const __m256i diferenciasAntes = _mm256_set1_epi64x((long long)nivel->diferenciasUsadas);
+    const __m256i reflejadasAntes = _mm256_set1_epi64x((long long)nivel->diferenciasReflejadas);
+    const __m256i mascaraUltima = _mm256_set1_epi64x((long long)nivel->mascaraUltima);
+    const __m256i requeridos = _mm256_set1_epi64x((long long)nivel->requeridosUltima);
+    unsigned long hojas = 0;
+
+    while (candidatos) {
+        // Un hermano por carril; los carriles sobrantes quedan invalidos
+        long long numeros[4] = {0, 0, 0, 0};
+        long long validos[4] = {0, 0, 0, 0};
+        for (int k = 0; k < 4 && candidatos; k++) {
+            numeros[k] = __builtin_ctzll(candidatos);
+            validos[k] = -1;
+            candidatos &= candidatos - 1;
+        }
+        __m256i numero = _mm256_loadu_si256((const __m256i *)numeros);
+
+        // |numero - anterior| con el signo como mascara
+        __m256i resta = _mm256_sub_epi64(numero, anterior);
+        __m256i signo = _mm256_cmpgt_epi64(cero, resta);
+        __m256i diferencia = _mm256_sub_epi64(_mm256_xor_si256(resta, signo), signo);
+
+        __m256i usados = _mm256_or_si256(usadosAntes, _mm256_sllv_epi64(uno, numero));
+        __m256i diferencias = _mm256_or_si256(diferenciasAntes, _mm256_sllv_epi64(uno, diferencia));
+        __m256i reflejadas = _mm256_or_si256(reflejadasAntes,
+                                             _mm256_sllv_epi64(uno, _mm256_sub_epi64(sesentaYTres, diferencia)));
+        __m256i prohibidos = _mm256_or_si256(_mm256_sllv_epi64(diferencias, numero),
+                                             _mm256_srlv_epi64(reflejadas, _mm256_sub_epi64(sesentaYTres, numero)));
+        __m256i ultima = _mm256_andnot_si256(prohibidos, _mm256_andnot_si256(usados, mascaraUltima));
+        if (nivel->mascaraTrasNumero != NULL) {
+            ultima = _mm256_and_si256(ultima, _mm256_i64gather_epi64((const long long *)nivel->mascaraTrasNumero, numero, 8));
+        }
+        __m256i completos = _mm256_cmpeq_epi64(_mm256_andnot_si256(usados, requeridos), cero);
+        ultima = _mm256_and_si256(ultima, _mm256_and_si256(completos, _mm256_loadu_si256((const __m256i *)validos)));
+
+        uint64_t carriles[4];
+        _mm256_storeu_si256((__m256i *)carriles, ultima);
+        hojas += __builtin_popcountll(carriles[0]) + __builtin_popcountll(carriles[1]) +
+                 __builtin_popcountll(carriles[2]) + __builtin_popcountll(carriles[3]);
+    }
+    return hojas;
+}
+
+/**
+ * @brief Versión AVX-512: ocho hermanos por iteración y popcount vectorial.
+ */
+__attribute__((target("avx512f,avx512vpopcntdq")))
+static unsigned long contarPenultimoAvx512(const nivelPenultimo_t *nivel, uint64_t candidatos) {
+    const __m512i uno = _mm512_set1_epi64(1);
+    const __m512i sesentaYTres = _mm512_set1_epi64(63);
+    const __m512i anterior = _mm512_set1_epi64(nivel->anterior);
+    const __m512i usadosAntes = _mm512_set1_epi64((long long)nivel->numerosUsados);
+    const __m512i diferenciasAntes = _mm512_set1_epi64((long long)nivel->diferenciasUsadas);
+    const __m512i reflejadasAntes = _mm512_set1_epi64((long long)nivel->diferenciasReflejadas);
+    const __m512i mascaraUltima = _mm512_set1_epi64((long long)nivel->mascaraUltima);
+    const __m512i requeridos = _mm512_set1_epi64((long long)nivel->requeridosUltima);
+    __m512i suma = _mm512_setzero_si512();
+
+    while (candidatos) {
+        long long numeros[8];
+        int k = 0;
+        for (; k < 8 && candidatos; k++) {
+            numeros[k] = __builtin_ctzll(candidatos);
+            candidatos &= candidatos - 1;
+        }
+        __mmask8 validos = (__mmask8)((1u << k) - 1);
+        __m512i numero = _mm512_maskz_loadu_epi64(validos, numeros);
+
+        __m512i diferencia = _mm512_abs_epi64(_mm512_sub_epi64(numero, anterior));
+        __m512i usados = _mm512_or_si512(usadosAntes, _mm512_sllv_epi64(uno, numero));
+        __m512i diferencias = _mm512_or_si512(diferenciasAntes, _mm512_sllv_epi64(uno, diferencia));
+        __m512i reflejadas = _mm512_or_si512(reflejadasAntes,
+                                             _mm512_sllv_epi64(uno, _mm512_sub_epi64(sesentaYTres, diferencia)));
+        __m512i prohibidos = _mm512_or_si512(_mm512_sllv_epi64(diferencias, numero),
+                                             _mm512_srlv_epi64(reflejadas, _mm512_sub_epi64(sesentaYTres, numero)));
+        __m512i ultima = _mm512_andnot_si512(prohibidos, _mm512_andnot_si512(usados, mascaraUltima));
+        if (nivel->mascaraTrasNumero != NULL) {
+            ultima = _mm512_and_si512(ultima, _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), validos, numero,
+                                                                          (const long long *)nivel->mascaraTrasNumero, 8));
+        }
+        // Carriles validos en los que ya estan todos los numeros requeridos
+        __mmask8 completos = validos & _mm512_testn_epi64_mask(requeridos, _mm512_andnot_si512(usados, requeridos));
+        suma = _mm512_add_epi64(suma, _mm512_maskz_popcnt_epi64(completos, ultima));
+    }
+    return (unsigned long)_mm512_reduce_add_epi64(suma);
+}
+#endif
+
+contadorHojas_t elegirContadorHojas(int permitirSimd) {
+#ifdef HAY_SIMD_X86
+    if (permitirSimd) {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq")) {
+            return contarPenultimoAvx512;
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+            return contarPenultimoAvx2;
+        }
+    }
+#else
+    (void)permitirSimd;
+#endif
+    return contarPenultimoEscalar;
+}
+
+const char *nombreContadorHojas(contadorHojas_t contador) {
+#ifdef HAY_SIMD_X86
+    if (contador == contarPenultimoAvx512) {
+        return "avx512";
+    }
+    if (contador == contarPenultimoAvx2) {
+        return "avx2";
+    }
+#endif
+    (void)contador;
+    return "escalar";
+}
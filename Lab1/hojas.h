@@ -0,0 +1,87 @@
+/**
+ * @file hojas.h
+ * @brief Conteo de las dos últimas posiciones con instrucciones vectoriales.
+ *
+ * Cerca de las hojas el trabajo es casi todo revisar qué diferencias quedan
+ * libres. Cuando el motor iterativo llega a la penúltima posición no apila
+ * ese nivel: cada hermano (cada candidato de la penúltima posición) da una
+ * máscara de candidatos para la última, y el número de hojas es su
+ * popcount. Los hermanos se evalúan juntos, uno por carril, con AVX-512
+ * (8 carriles) o AVX2 (4 carriles) si el procesador los tiene, y con código
+ * escalar si no.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#ifndef HOJAS_H
+#define HOJAS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Estado de la búsqueda justo antes de llenar la penúltima posición.
+ */
+typedef struct {
+    int anterior;                   ///< Número en la antepenúltima posición.
+    uint64_t numerosUsados;         ///< Números usados hasta la antepenúltima posición.
+    uint64_t diferenciasUsadas;     ///< Diferencias usadas, bit d.
+    uint64_t diferenciasReflejadas; ///< Diferencias usadas, bit 63 - d.
+    uint64_t mascaraUltima;         ///< Números permitidos en la última posición.
+    uint64_t requeridosUltima;      ///< Números que deben estar usados al llegar a la última posición.
+    const uint64_t *mascaraTrasNumero; ///< Números permitidos después de cada número.
+} nivelPenultimo_t;
+
+/**
+ * @brief Candidatos de la última posición si se coloca un número en la penúltima.
+ *
+ * @param nivel Estado antes de llenar la penúltima posición.
+ * @param numero Candidato colocado en la penúltima posición.
+ * @return uint64_t Máscara de candidatos válidos de la última posición.
+ */
+static inline uint64_t candidatosUltima(const nivelPenultimo_t *nivel, int numero) {
+    // Las mismas marcas que alternarNumero(), sin deshacerlas despues
+    int diferencia = numero > nivel->anterior ? numero - nivel->anterior : nivel->anterior - numero;
+    uint64_t usados = nivel->numerosUsados | 1ULL << numero;
+    uint64_t diferencias = nivel->diferenciasUsadas | 1ULL << diferencia;
+    uint64_t reflejadas = nivel->diferenciasReflejadas | 1ULL << (63 - diferencia);
+    uint64_t ultima = nivel->mascaraUltima & ~usados & ~((diferencias << numero) | (reflejadas >> (63 - numero)));
+    if (nivel->mascaraTrasNumero != NULL) {
+        ultima &= nivel->mascaraTrasNumero[numero];
+    }
+    return (nivel->requeridosUltima & ~usados) ? 0 : ultima;
+}
+
+/**
+ * @brief Cuenta las hojas bajo un grupo de hermanos de la penúltima posición.
+ *
+ * @param nivel Estado antes de llenar la penúltima posición.
+ * @param candidatos Candidatos válidos de la penúltima posición.
+ * @return unsigned long Suma, sobre los candidatos, de los candidatos válidos de la última posición.
+ */
+typedef unsigned long (*contadorHojas_t)(const nivelPenultimo_t *nivel, uint64_t candidatos);
+
+/**
+ * @brief Versión escalar, un hermano a la vez.
+ */
+unsigned long contarPenultimoEscalar(const nivelPenultimo_t *nivel, uint64_t candidatos);
+
+/**
+ * @brief Elige la mejor versión que soporta el procesador.
+ *
+ * @param permitirSimd 0 para forzar la versión escalar.
+ * @return contadorHojas_t Versión elegida.
+ */
+contadorHojas_t elegirContadorHojas(int permitirSimd);
+
+/**
+ * @brief Nombre de una versión, para mostrarlo.
+ *
+ * @param contador Versión devuelta por elegirContadorHojas().
+ * @return const char* "avx512", "avx2" o "escalar".
+ */
+const char *nombreContadorHojas(contadorHojas_t contador);
+
+#endif // HOJAS_H
@@ -0,0 +1,305 @@
+/**
+ * @file instrumentacion.c
+ * @brief Estadísticas por nivel, serie de nodos por segundo y contadores de hardware.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include "cancelacion.h"
+#include "instrumentacion.h"
+
+static unsigned long nodosNivel[64];     ///< Nodos de cada nivel sumados de todos los estados.
+static unsigned long sinSalidaNivel[64]; ///< Nodos sin candidatos de cada nivel.
+
+static _Atomic unsigned long nodosTotales; ///< Nodos publicados por todos los hilos.
+
+/**
+ * @brief Una muestra de la serie de tiempo.
+ */
+typedef struct {
+    double segundos;     ///< Tiempo desde iniciarMuestreo().
+    unsigned long nodos; ///< Nodos publicados hasta ese momento.
+} muestra_t;
+
+static muestra_t muestras[MAX_MUESTRAS];
+static int numMuestras;
+static double intervalo;
+static double inicioMuestreo;
+static atomic_int detenerMuestreador;
+static pthread_t muestreador;
+static int muestreadorActivo;
+
+static const char *nombresContadores[NUM_CONTADORES] = {
+    "ciclos", "instrucciones", "fallos_prediccion_saltos", "fallos_l1d"
+};
+
+void registrarNiveles(const busquedaBits_t *b) {
+#ifdef INSTRUMENTAR
+    for (int nivel = 0; nivel <= b->N && nivel < 64; nivel++) {
+        nodosNivel[nivel] += b->nodosNivel[nivel];
+        sinSalidaNivel[nivel] += b->sinSalidaNivel[nivel];
+    }
+#else
+    (void)b;
+#endif
+}
+
+void publicarNodos(busquedaBits_t *b) {
+#ifdef INSTRUMENTAR
+    // Quien reinicia b->nodos (el robo de trabajo) también deja de sumar desde cero.
+    if (b->nodos < b->nodosPublicados) {
+        b->nodosPublicados = 0;
+    }
+    atomic_fetch_add_explicit(&nodosTotales, b->nodos - b->nodosPublicados, memory_order_relaxed);
+    b->nodosPublicados = b->nodos;
+#else
+    (void)b;
+#endif
+}
+
+/**
+ * @brief Agrega una muestra; si no hay espacio conserva una de cada dos y duplica el intervalo.
+ */
+static void tomarMuestra(void) {
+    if (numMuestras == MAX_MUESTRAS) {
+        for (int i = 0; i < MAX_MUESTRAS / 2; i++) {
+            muestras[i] = muestras[2 * i + 1];
+        }
+        numMuestras = MAX_MUESTRAS / 2;
+        intervalo *= 2;
+    }
+    muestras[numMuestras].segundos = relojMonotonico() - inicioMuestreo;
+    muestras[numMuestras].nodos = atomic_load_explicit(&nodosTotales, memory_order_relaxed);
+    numMuestras++;
+}
+
+static void *bucleMuestreo(void *argumento) {
+    (void)argumento;
+    double siguiente = inicioMuestreo + intervalo;
+    while (!atomic_load(&detenerMuestreador)) {
+        // Dormir en pasos cortos para que detenerMuestreo() no espere un intervalo completo.
+        struct timespec paso = {0, 10 * 1000 * 1000};
+        nanosleep(&paso, NULL);
+        if (relojMonotonico() >= siguiente) {
+            tomarMuestra();
+            siguiente += intervalo;
+        }
+    }
+    return NULL;
+}
+
+int iniciarMuestreo(void) {
+    atomic_store(&nodosTotales, 0);
+    atomic_store(&detenerMuestreador, 0);
+    numMuestras = 0;
+    intervalo = INTERVALO_MUESTREO;
+    inicioMuestreo = relojMonotonico();
+    tomarMuestra();
+    muestreadorActivo = pthread_create(&muestreador, NULL, bucleMuestreo, NULL) == 0;
+    return muestreadorActivo ? 0 : -1;
+}
+
+void detenerMuestreo(void) {
+    if (muestreadorActivo) {
+        atomic_store(&detenerMuestreador, 1);
+        pthread_join(muestreador, NULL);
+        muestreadorActivo = 0;
+    }
+    tomarMuestra();
+}
+
+void iniciarContadoresHardware(contadoresHardware_t *c) {
+    memset(c, 0, sizeof(*c));
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        c->descriptores[i] = -1;
+    }
+#ifdef __linux__
+    static const struct {
+        uint32_t tipo;
+        uint64_t configuracion;
+    } eventos[NUM_CONTADORES] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    };
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        struct perf_event_attr atributos;
+        memset(&atributos, 0, sizeof(atributos));
+        atributos.size = sizeof(atributos);
+        atributos.type = eventos[i].tipo;
+        atributos.config = eventos[i].configuracion;
+        atributos.disabled = 1;
+        atributos.inherit = 1; // Cuenta también los hilos creados después de abrirlo.
+        atributos.exclude_kernel = 1;
+        atributos.exclude_hv = 1;
+        // Cada contador por separado: inherit no permite leer grupos.
+        int fd = (int)syscall(SYS_perf_event_open, &atributos, 0, -1, -1, 0);
+        if (fd < 0) {
+            if (c->error == 0) {
+                c->error = errno;
+            }
+            continue;
+        }
+        c->descriptores[i] = fd;
+    }
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        if (c->descriptores[i] >= 0) {
+            ioctl(c->descriptores[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(c->descriptores[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#else
+    c->error = ENOSYS;
+#endif
+}
+
+void detenerContadoresHardware(contadoresHardware_t *c) {
+#ifdef __linux__
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        if (c->descriptores[i] >= 0) {
+            ioctl(c->descriptores[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        if (c->descriptores[i] < 0) {
+            continue;
+        }
+        uint64_t valor;
+        if (read(c->descriptores[i], &valor, sizeof(valor)) == (ssize_t)sizeof(valor)) {
+            c->valores[i] = valor;
+            c->leidos[i] = 1;
+        } else if (c->error == 0) {
+            c->error = errno;
+        }
+        close(c->descriptores[i]);
+        c->descriptores[i] = -1;
+    }
+#else
+    (void)c;
+#endif
+}
+
+/**
+ * @brief Escribe un cociente o null si el divisor es cero.
+ */
+static void escribirCociente(FILE *f, double numerador, double divisor) {
+    if (divisor > 0) {
+        fprintf(f, "%.6g", numerador / divisor);
+    } else {
+        fprintf(f, "null");
+    }
+}
+
+int escribirInforme(const char *archivo, const resumenInforme_t *resumen, const contadoresHardware_t *contadores) {
+    FILE *f = strcmp(archivo, "-") == 0 ? stdout : fopen(archivo, "w");
+    if (f == NULL) {
+        perror(archivo);
+        return -1;
+    }
+
+    fprintf(f, "{\n");
+    fprintf(f, "  \"N\": %d,\n", resumen->N);
+    fprintf(f, "  \"simetria\": %s,\n", resumen->simetria ? "true" : "false");
+    fprintf(f, "  \"hilos\": %d,\n", resumen->hilos);
+    fprintf(f, "  \"fragmento\": %d,\n", resumen->fragmento);
+    fprintf(f, "  \"fragmentos\": %d,\n", resumen->fragmentos);
+    fprintf(f, "  \"completa\": %s,\n", resumen->tiempoAgotado ? "false" : "true");
+    fprintf(f, "  \"permutaciones\": %lu,\n", resumen->totalPermutaciones);
+    fprintf(f, "  \"nodos\": %lu,\n", resumen->nodos);
+    fprintf(f, "  \"segundos\": %.6f,\n", resumen->segundos);
+    fprintf(f, "  \"nodos_por_segundo\": ");
+    escribirCociente(f, (double)resumen->nodos, resumen->segundos);
+    fprintf(f, ",\n");
+
+    // poda: fracción de los nodos del nivel sin candidatos para el siguiente.
+    // ramificacion: hijos promedio de un nodo del nivel.
+    fprintf(f, "  \"niveles\": [\n");
+    for (int nivel = 0; nivel <= resumen->N && nivel < 64; nivel++) {
+        fprintf(f, "    {\"nivel\": %d, \"nodos\": %lu, \"sin_salida\": %lu, \"poda\": ",
+                nivel, nodosNivel[nivel], sinSalidaNivel[nivel]);
+        escribirCociente(f, (double)sinSalidaNivel[nivel], (double)nodosNivel[nivel]);
+        fprintf(f, ", \"ramificacion\": ");
+        if (nivel < resumen->N) {
+            escribirCociente(f, (double)nodosNivel[nivel + 1], (double)nodosNivel[nivel]);
+        } else {
+            fprintf(f, "null");
+        }
+        fprintf(f, "}%s\n", nivel < resumen->N ? "," : "");
+    }
+    fprintf(f, "  ],\n");
+
+    fprintf(f, "  \"intervalo_muestreo\": %.3f,\n", intervalo);
+    fprintf(f, "  \"serie\": [\n");
+    for (int i = 0; i < numMuestras; i++) {
+        fprintf(f, "    {\"segundos\": %.3f, \"nodos\": %lu, \"nodos_por_segundo\": ",
+                muestras[i].segundos, muestras[i].nodos);
+        if (i > 0) {
+            escribirCociente(f, (double)(muestras[i].nodos - muestras[i - 1].nodos),
+                             muestras[i].segundos - muestras[i - 1].segundos);
+        } else {
+            fprintf(f, "null");
+        }
+        fprintf(f, "}%s\n", i + 1 < numMuestras ? "," : "");
+    }
+    fprintf(f, "  ],\n");
+
+    fprintf(f, "  \"contadores\": {\n");
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        if (contadores->leidos[i]) {
+            fprintf(f, "    \"%s\": %llu,\n", nombresContadores[i], (unsigned long long)contadores->valores[i]);
+        } else {
+            fprintf(f, "    \"%s\": null,\n", nombresContadores[i]);
+        }
+    }
+    int ciclos = contadores->leidos[0];
+    int instrucciones = contadores->leidos[1];
+    fprintf(f, "    \"ipc\": ");
+    if (ciclos && instrucciones) {
+        escribirCociente(f, (double)contadores->valores[1], (double)contadores->valores[0]);
+    } else {
+        fprintf(f, "null");
+    }
+    fprintf(f, ",\n");
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        fprintf(f, "    \"%s_por_nodo\": ", nombresContadores[i]);
+        if (contadores->leidos[i]) {
+            escribirCociente(f, (double)contadores->valores[i], (double)resumen->nodos);
+        } else {
+            fprintf(f, "null");
+        }
+        fprintf(f, ",\n");
+    }
+    if (contadores->error != 0) {
+        fprintf(f, "    \"error\": \"%s\"\n", strerror(contadores->error));
+    } else {
+        fprintf(f, "    \"error\": null\n");
+    }
+    fprintf(f, "  }\n");
+    fprintf(f, "}\n");
+
+    if (f != stdout) {
+        if (fclose(f) != 0) {
+            perror(archivo);
+            return -1;
+        }
+    }
+    return 0;
+}
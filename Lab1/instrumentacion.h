@@ -0,0 +1,112 @@
+/**
+ * @file instrumentacion.h
+ * @brief Medición detallada de la búsqueda para ajustar el motor.
+ *
+ * Al compilar con -DINSTRUMENTAR el motor iterativo cuenta los nodos de
+ * cada nivel y los que no tienen candidatos (podados), y publica sus nodos
+ * cada rebanada para una serie de nodos por segundo en el tiempo. Alrededor
+ * de la búsqueda se leen contadores de hardware con perf_event_open (solo
+ * Linux) y todo se escribe en un informe JSON con `--informe`.
+ *
+ * En la compilación normal el motor no llama a nada de este módulo.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#ifndef INSTRUMENTACION_H
+#define INSTRUMENTACION_H
+
+#include <stdint.h>
+
+#include "busqueda.h"
+
+#define INTERVALO_MUESTREO 0.1  ///< Segundos entre dos muestras de la serie de tiempo.
+#define MAX_MUESTRAS 4096       ///< Muestras guardadas; al llenarse se descarta una de cada dos.
+#define NUM_CONTADORES 4        ///< Contadores de hardware que se intentan abrir.
+
+/**
+ * @brief Contadores de hardware de todo el proceso, incluidos los hilos que cree.
+ */
+typedef struct {
+    int descriptores[NUM_CONTADORES]; ///< Descriptor de cada contador, o -1 si no se pudo abrir.
+    uint64_t valores[NUM_CONTADORES]; ///< Valores leídos al detenerlos.
+    int leidos[NUM_CONTADORES];       ///< 1 si el valor del contador es válido.
+    int error;                        ///< errno del primer contador que falló, o 0.
+} contadoresHardware_t;
+
+/**
+ * @brief Datos generales de la ejecución para el informe.
+ */
+typedef struct {
+    int N;                            ///< Tamaño del conjunto de números.
+    int simetria;                     ///< 1 si se contaron solo representantes canónicos.
+    int hilos;                        ///< Hilos de trabajo (0: secuencial).
+    int fragmento;                    ///< Fragmento contado.
+    int fragmentos;                   ///< Número de fragmentos.
+    int tiempoAgotado;                ///< 1 si la búsqueda no terminó.
+    unsigned long totalPermutaciones; ///< Permutaciones gráciles encontradas.
+    unsigned long nodos;              ///< Nodos visitados.
+    double segundos;                  ///< Tiempo de pared de la búsqueda.
+} resumenInforme_t;
+
+/**
+ * @brief Suma las estadísticas por nivel de un estado a las del proceso.
+ *
+ * Se llama una vez por estado, cuando ningún hilo lo está usando.
+ *
+ * @param b Estado de la búsqueda.
+ */
+void registrarNiveles(const busquedaBits_t *b);
+
+/**
+ * @brief Suma a la serie de tiempo los nodos nuevos de un estado.
+ *
+ * @param b Estado de la búsqueda (solo lo modifica el hilo dueño).
+ */
+void publicarNodos(busquedaBits_t *b);
+
+/**
+ * @brief Lanza el hilo que toma una muestra de los nodos cada INTERVALO_MUESTREO.
+ *
+ * @return int 0 si se pudo lanzar, -1 si no.
+ */
+int iniciarMuestreo(void);
+
+/**
+ * @brief Detiene el hilo de muestreo y toma una última muestra.
+ */
+void detenerMuestreo(void);
+
+/**
+ * @brief Abre y arranca los contadores de hardware.
+ *
+ * Los que no se puedan abrir (sin permisos, en una máquina virtual o fuera
+ * de Linux) quedan como no disponibles en el informe.
+ *
+ * @param c Contadores a inicializar.
+ */
+void iniciarContadoresHardware(contadoresHardware_t *c);
+
+/**
+ * @brief Detiene los contadores, lee sus valores y los cierra.
+ *
+ * Los hilos de trabajo ya deben haber terminado para que sus cuentas se
+ * sumen a las del proceso.
+ *
+ * @param c Contadores iniciados con iniciarContadoresHardware().
+ */
+void detenerContadoresHardware(contadoresHardware_t *c);
+
+/**
+ * @brief Escribe el informe JSON.
+ *
+ * @param archivo Ruta del archivo, o "-" para la salida estándar.
+ * @param resumen Datos generales de la ejecución.
+ * @param contadores Contadores de hardware ya detenidos.
+ * @return int 0 si se pudo escribir, -1 si no.
+ */
+int escribirInforme(const char *archivo, const resumenInforme_t *resumen, const contadoresHardware_t *contadores);
+
+#endif // INSTRUMENTACION_H
@@ -11,57 +11,207 @@
  * @version 1.0
  */
 
+ #include <math.h>
+ #include <signal.h>
  #include <stdio.h>
  #include <stdlib.h>
+ #include <string.h>
  #include <time.h>
  
+ #include "busqueda.h"
+ #include "cancelacion.h"
+ #include "estimacion.h"
+ #include "fragmentos.h"
+ #include "generador.h"
+ #include "hilos.h"
+ #include "instrumentacion.h"
+ #include "punto_control.h"
+ #include "salida.h"
+ #include "robo.h"
+ #include "transposicion.h"
+ 
+ /** @brief Cancelación de la búsqueda en curso, visible para el manejador de SIGINT. */
+ static cancelacion_t cancelacion;
+ /** @brief Se pone en 1 si la búsqueda se detuvo por Ctrl+C y no por tiempo. */
+ static volatile sig_atomic_t interrumpido = 0;
+ 
  /**
-  * @brief Encuentra permutaciones gráciles de forma recursiva.
+  * @brief Manejador de Ctrl+C: pide a la búsqueda que pare y muestre el conteo parcial.
   *
-  * @param posicionActual Posición actual en el arreglo de permutaciones.
-  * @param N Tamaño del conjunto de números.
-  * @param arregloNumeros Arreglo que almacena la permutación actual.
-  * @param numerosUsados Arreglo de seguimiento de números ya utilizados.
-  * @param diferenciasUsadas Arreglo de seguimiento de diferencias utilizadas.
-  * @param totalPermutaciones Contador de permutaciones válidas encontradas.
-  * @param tiempoInicio Tiempo de inicio de la ejecución.
-  * @param M Tiempo máximo de ejecución en minutos.
+  * @param senal Número de la señal recibida.
   */
- // Funcion recursiva para encontrar permutaciones graciles
- void encontrarPermutaciones(int posicionActual, int N, int arregloNumeros[], int numerosUsados[], int diferenciasUsadas[], long *totalPermutaciones, clock_t tiempoInicio, int M) {
-     // Verificar si se ha superado el tiempo limite
-     double tiempoTranscurrido = (double)(clock() - tiempoInicio) / CLOCKS_PER_SEC;
-     if (tiempoTranscurrido >= M * 60) {
-         return;
+ static void manejarInterrupcion(int senal) {
+     (void)senal;
+     interrumpido = 1;
+     solicitarParada(&cancelacion);
+ }
+ 
+ /**
+  * @brief Muestra la forma de uso del programa.
+  *
+  * @param programa Nombre con el que se ejecutó el programa.
+  */
+ static void mostrarUso(const char *programa) {
+     printf("Uso: %s <N> <M> [opciones]\n", programa);
+     printf("     %s --merge ARCHIVO...   Suma los resultados de todos los fragmentos\n", programa);
+     printf("     %s --range a..b <M> [opciones]   Cuenta cada N de a a b con un solo grupo de hilos\n", programa);
+     printf("Opciones:\n");
+     printf("  --motor NOMBRE     Motor secuencial: iterativo (por defecto), bits u original\n");
+     printf("  --recursivo        Igual que --motor original\n");
+     printf("  --generico         Usa el nucleo iterativo generico en lugar del especializado para N\n");
+     printf("  --sin-simd         Cuenta las ultimas posiciones sin instrucciones AVX2/AVX-512\n");
+     printf("  --sin-propagacion  No poda con las diferencias grandes que ya no se pueden formar\n");
+     printf("  --threads K        Reparte la busqueda entre K hilos (robo de trabajo)\n");
+     printf("  --estatico         Con --threads, reparte prefijos fijos en lugar de robar trabajo\n");
+     printf("  --simetria         Recorre solo representantes por reverso y complemento\n");
+     printf("  --checkpoint ARCH  Guarda puntos de control periodicos en ARCH\n");
+     printf("  --intervalo S      Segundos entre puntos de control (por defecto %.0f)\n", INTERVALO_PUNTO_CONTROL);
+     printf("  --resume ARCH      Continua la busqueda guardada en ARCH\n");
+     printf("  --memo MB          Tabla de transposicion de MB MiB para no repetir subarboles\n");
+     printf("  --shard i/k        Cuenta solo el fragmento i (0..k-1) de k procesos independientes\n");
+     printf("  --resultado ARCH   Archivo de resultado del fragmento (por defecto fragmento_N<N>_<i>_de_<k>.txt)\n");
+     printf("  --salida ARCH      Escribe cada permutacion en el archivo binario ARCH\n");
+     printf("  --listar K         Muestra las primeras K permutaciones en orden lexicografico\n");
+     printf("  --estimate         Estima nodos, permutaciones y tiempo en unos segundos, sin contar\n");
+     printf("  --informe ARCH     Informe JSON por nivel y de contadores (compilado con -DINSTRUMENTAR)\n");
+     printf("  --progreso S       Muestra en stderr velocidad, avance y tiempo restante cada S segundos\n");
+     printf("  --progreso-json    Muestra el progreso como lineas JSON (cada %.0f s sin --progreso)\n", INTERVALO_PROGRESO);
+ }
+ 
+ /**
+  * @brief Lee un rango de N escrito como "a..b".
+  *
+  * @param texto Texto a interpretar.
+  * @param desde Menor N del rango.
+  * @param hasta Mayor N del rango.
+  * @return int 0 si el rango es válido (1 < a <= b < 50), -1 si no.
+  */
+ static int leerRango(const char *texto, int *desde, int *hasta) {
+     char resto;
+     if (sscanf(texto, "%d..%d%c", desde, hasta, &resto) != 2) {
+         return -1;
      }
-     
-     // Si se llenaron todas las posiciones, se encontro una permutacion valida
-     if (posicionActual == N) {
-         (*totalPermutaciones)++;
+     if (*desde <= 1 || *hasta >= 50 || *desde > *hasta) {
+         return -1;
+     }
+     return 0;
+ }
+ 
+ /**
+  * @brief Cuenta todos los N de un rango y muestra una tabla por N.
+  *
+  * @param parametros Parámetros comunes de la búsqueda.
+  * @param desde Menor N del rango.
+  * @param hasta Mayor N del rango.
+  * @param hilos Hilos de trabajo.
+  * @param intervaloProgreso Segundos entre reportes de progreso (0: sin reporte).
+  * @param progresoJson 1 para reportar el progreso como líneas JSON.
+  * @return int Código de salida del programa.
+  */
+ static int contarRango(const parametrosBusqueda_t *parametros, int desde, int hasta, int hilos, double intervaloProgreso, int progresoJson) {
+     int numProblemas = hasta - desde + 1;
+     resultadoBusqueda_t resultados[N_MAXIMO + 1];
+     tiempoProblema_t tiempos[N_MAXIMO + 1];
+     configEjecutor_t config;
+     config.hilos = hilos;
+     config.robar = 1;
+     config.archivoPuntoControl = NULL;
+     config.intervaloPuntoControl = INTERVALO_PUNTO_CONTROL;
+     config.fragmento = 0;
+     config.fragmentos = 1;
+     config.intervaloProgreso = intervaloProgreso;
+     config.progresoJson = progresoJson;
+     if (buscarRango(parametros, desde, hasta, &config, resultados, tiempos, NULL) != 0) {
+         printf("No se pudieron crear los hilos de trabajo\n");
+         return 1;
+     }
+     double tiempoTotal = tiempoTranscurrido(parametros->cancelacion);
+ 
+     unsigned long nodos = 0;
+     int incompletos = 0;
+     printf("Rango de N: %d..%d con %d hilo(s)\n", desde, hasta, hilos);
+     printf("%4s %15s %16s %14s %18s\n", "N", "Permutaciones", "Nodos", "Terminado (s)", "Tiempo hilos (s)");
+     for (int p = 0; p < numProblemas; p++) {
+         printf("%4d %15lu %16lu %14.3f %18.3f%s\n", desde + p, resultados[p].totalPermutaciones,
+                resultados[p].nodos, tiempos[p].terminado, tiempos[p].segundosHilos,
+                resultados[p].tiempoAgotado ? "  (parcial)" : "");
+         nodos += resultados[p].nodos;
+         incompletos += resultados[p].tiempoAgotado;
+     }
+     if (incompletos > 0) {
+         printf("[AVISO] %s; %d valor(es) de N sin terminar.\n",
+                interrumpido ? "Busqueda interrumpida por el usuario" : "No se pudo terminar en el tiempo limite",
+                incompletos);
+     }
+     printf("Tiempo total de ejecucion: %.6f segundos\n", tiempoTotal);
+     if (tiempoTotal > 0) {
+         printf("Nodos explorados: %lu (%.0f nodos/s)\n", nodos, nodos / tiempoTotal);
+     }
+     return 0;
+ }
+ 
+ /**
+  * @brief Escribe una duración en la unidad más legible.
+  *
+  * @param texto Donde se escribe.
+  * @param tam Tamaño de `texto`.
+  * @param segundos Duración en segundos.
+  */
+ static void formatearDuracion(char *texto, size_t tam, double segundos) {
+     if (segundos < 120) {
+         snprintf(texto, tam, "%.1f s", segundos);
+     } else if (segundos < 2 * 3600) {
+         snprintf(texto, tam, "%.1f min", segundos / 60);
+     } else if (segundos < 2 * 86400) {
+         snprintf(texto, tam, "%.1f h", segundos / 3600);
+     } else if (segundos < 2 * 365.25 * 86400) {
+         snprintf(texto, tam, "%.1f dias", segundos / 86400);
+     } else {
+         snprintf(texto, tam, "%.3g anos", segundos / (365.25 * 86400));
+     }
+ }
+ 
+ /**
+  * @brief Muestra una estimación y el tiempo que tomaría la búsqueda real.
+  *
+  * El tiempo con varios hilos o fragmentos supone que la velocidad escala
+  * linealmente, así que es una cota optimista.
+  *
+  * @param e Estimación calculada con estimarArbol().
+  * @param hilos Hilos que usaría la búsqueda (0 o 1: secuencial).
+  * @param fragmentos Fragmentos en que se repartiría.
+  */
+ static void mostrarEstimacion(const estimacionArbol_t *e, int hilos, int fragmentos) {
+     char duracion[3][32];
+     if (e->exacto) {
+         printf("El arbol se recorrio completo durante la calibracion (valores exactos)\n");
+     } else {
+         printf("Sondas aleatorias: %lu\n", e->sondas);
+     }
+     printf("Nodos estimados: %.4g (IC 95%%: %.4g a %.4g)\n", e->nodos,
+            fmax(e->nodos - e->errorNodos, 0), e->nodos + e->errorNodos);
+     printf("Permutaciones graciles estimadas: %.4g (IC 95%%: %.4g a %.4g)\n", e->permutaciones,
+            fmax(e->permutaciones - e->errorPermutaciones, 0), e->permutaciones + e->errorPermutaciones);
+     printf("Velocidad medida: %.4g nodos/s por hilo\n", e->nodosPorSegundo);
+     if (e->nodosPorSegundo <= 0) {
          return;
      }
-     
-     // Intentar colocar un numero en la posicion actual
-     for (int numeroIntento = 1; numeroIntento <= N; numeroIntento++) {
-         if (!numerosUsados[numeroIntento]) {  // Si el numero no ha sido usado
-             // Si es la primera posicion o la diferencia es unica
-             if (posicionActual == 0 || !diferenciasUsadas[abs(numeroIntento - arregloNumeros[posicionActual - 1])]) {
-                 arregloNumeros[posicionActual] = numeroIntento;
-                 numerosUsados[numeroIntento] = 1;
-                 if (posicionActual > 0) {
-                     int diferencia = abs(numeroIntento - arregloNumeros[posicionActual - 1]);
-                     diferenciasUsadas[diferencia] = 1;
-                 }
-                 // Llamada recursiva para la siguiente posicion
-                 encontrarPermutaciones(posicionActual + 1, N, arregloNumeros, numerosUsados, diferenciasUsadas, totalPermutaciones, tiempoInicio, M);
-                 // Deshacer cambios para probar otra opcion
-                 if (posicionActual > 0) {
-                     int diferencia = abs(numeroIntento - arregloNumeros[posicionActual - 1]);
-                     diferenciasUsadas[diferencia] = 0;
-                 }
-                 numerosUsados[numeroIntento] = 0;
-             }
-         }
+ 
+     int unidades = (hilos > 1 ? hilos : 1) * fragmentos;  // Hilos trabajando a la vez
+     double segundos = e->nodos / e->nodosPorSegundo / unidades;
+     double minimo = fmax(e->nodos - e->errorNodos, 0) / e->nodosPorSegundo / unidades;
+     double maximo = (e->nodos + e->errorNodos) / e->nodosPorSegundo / unidades;
+     formatearDuracion(duracion[0], sizeof(duracion[0]), segundos);
+     formatearDuracion(duracion[1], sizeof(duracion[1]), minimo);
+     formatearDuracion(duracion[2], sizeof(duracion[2]), maximo);
+     printf("Tiempo estimado con %d hilo(s)", hilos > 1 ? hilos : 1);
+     if (fragmentos > 1) {
+         printf(" por fragmento de %d", fragmentos);
+     }
+     printf(": %s (IC 95%%: %s a %s)\n", duracion[0], duracion[1], duracion[2]);
+     if (isfinite(maximo)) {
+         // Margen de 25% sobre el extremo superior del intervalo
+         printf("M sugerido: %.0f minutos\n", ceil(maximo * 1.25 / 60));
      }
  }
  
@@ -73,13 +223,186 @@
   * @return int Código de salida del programa.
   */
  int main(int argc, char *argv[]) {
+     // Suma de fragmentos contados por procesos independientes
+     if (argc >= 2 && strcmp(argv[1], "--merge") == 0) {
+         return combinarFragmentos(argv + 2, argc - 2);
+     }
+ 
+     // Todos los N de un rango: "--range a..b" ocupa el lugar de N
+     const char *programa = argv[0];
+     int rangoDesde = 0;     // 0: un solo N
+     int rangoHasta = 0;
+     if (argc >= 2 && strcmp(argv[1], "--range") == 0) {
+         if (argc < 4 || leerRango(argv[2], &rangoDesde, &rangoHasta) != 0) {
+             printf("--range espera a..b con 1 < a <= b < 50, seguido de M\n");
+             return 1;
+         }
+         argv++;
+         argc--;
+     }
+ 
      // Verificar que el usuario ingreso los argumentos necesarios
-     if (argc != 3) {
-         printf("Uso: %s <N> <M>\n", argv[0]);
+     if (argc < 3) {
+         mostrarUso(programa);
+         return 1;
+     }
+ 
+     int usarRecursivo = 0;  // Motor original, para comparar
+     int motorRecursivoBits = 0; // Motor recursivo con mascaras, para comparar
+     int hilos = 0;          // 0: busqueda secuencial sin hilos
+     int repartoEstatico = 0; // Prefijos fijos en lugar de robo de trabajo
+     int simetria = 0;       // Solo representantes canonicos
+     const char *archivoPuntoControl = NULL; // Donde guardar puntos de control
+     const char *archivoReanudar = NULL;     // Punto de control a continuar
+     double intervalo = INTERVALO_PUNTO_CONTROL;
+     int fragmento = 0;      // Fragmento a contar con --shard
+     int fragmentos = 1;     // 1: el arbol completo
+     const char *archivoResultado = NULL;    // Resultado del fragmento
+     long megasTabla = 0;    // 0: sin tabla de transposicion
+     int estimar = 0;        // Solo estimar el tamano del arbol
+     const char *archivoSalida = NULL;       // Donde escribir las permutaciones
+     long listar = 0;        // Permutaciones a mostrar con el generador
+     int nucleoGenerico = 0; // Nucleo iterativo sin especializar, para comparar
+     int sinSimd = 0;        // Conteo de hojas escalar aunque haya AVX2/AVX-512
+     int sinPropagacion = 0; // Sin poda por diferencias grandes, para comparar
+     const char *archivoInforme = NULL;      // Informe JSON de la compilacion instrumentada
+     double intervaloProgreso = 0;           // 0: sin reporte de progreso
+     int progresoJson = 0;   // Progreso como lineas JSON
+     for (int i = 3; i < argc; i++) {
+         if (strcmp(argv[i], "--recursivo") == 0) {
+             usarRecursivo = 1;
+         } else if (strcmp(argv[i], "--motor") == 0 && i + 1 < argc) {
+             i++;
+             usarRecursivo = (strcmp(argv[i], "original") == 0);
+             motorRecursivoBits = (strcmp(argv[i], "bits") == 0);
+             if (!usarRecursivo && !motorRecursivoBits && strcmp(argv[i], "iterativo") != 0) {
+                 printf("Motor desconocido: %s\n", argv[i]);
+                 return 1;
+             }
+         } else if (strcmp(argv[i], "--generico") == 0) {
+             nucleoGenerico = 1;
+         } else if (strcmp(argv[i], "--sin-simd") == 0) {
+             sinSimd = 1;
+         } else if (strcmp(argv[i], "--sin-propagacion") == 0) {
+             sinPropagacion = 1;
+         } else if (strcmp(argv[i], "--simetria") == 0) {
+             simetria = 1;
+         } else if (strcmp(argv[i], "--estatico") == 0) {
+             repartoEstatico = 1;
+         } else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+             archivoPuntoControl = argv[++i];
+         } else if (strcmp(argv[i], "--resume") == 0 && i + 1 < argc) {
+             archivoReanudar = argv[++i];
+         } else if (strcmp(argv[i], "--intervalo") == 0 && i + 1 < argc) {
+             intervalo = atof(argv[++i]);
+             if (intervalo <= 0) {
+                 printf("El intervalo entre puntos de control debe ser positivo\n");
+                 return 1;
+             }
+         } else if (strcmp(argv[i], "--shard") == 0 && i + 1 < argc) {
+             if (leerFragmento(argv[++i], &fragmento, &fragmentos) != 0) {
+                 printf("--shard espera i/k con 0 <= i < k <= %d\n", MAX_FRAGMENTOS);
+                 return 1;
+             }
+         } else if (strcmp(argv[i], "--memo") == 0 && i + 1 < argc) {
+             megasTabla = atol(argv[++i]);
+             if (megasTabla <= 0) {
+                 printf("El tamano de la tabla debe ser positivo (MiB)\n");
+                 return 1;
+             }
+         } else if (strcmp(argv[i], "--salida") == 0 && i + 1 < argc) {
+             archivoSalida = argv[++i];
+         } else if (strcmp(argv[i], "--listar") == 0 && i + 1 < argc) {
+             listar = atol(argv[++i]);
+             if (listar <= 0) {
+                 printf("--listar espera un numero positivo de permutaciones\n");
+                 return 1;
+             }
+         } else if (strcmp(argv[i], "--informe") == 0 && i + 1 < argc) {
+             archivoInforme = argv[++i];
+         } else if (strcmp(argv[i], "--progreso") == 0 && i + 1 < argc) {
+             intervaloProgreso = atof(argv[++i]);
+             if (intervaloProgreso <= 0) {
+                 printf("El intervalo entre reportes de progreso debe ser positivo\n");
+                 return 1;
+             }
+         } else if (strcmp(argv[i], "--progreso-json") == 0) {
+             progresoJson = 1;
+         } else if (strcmp(argv[i], "--estimate") == 0) {
+             estimar = 1;
+         } else if (strcmp(argv[i], "--resultado") == 0 && i + 1 < argc) {
+             archivoResultado = argv[++i];
+         } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+             hilos = atoi(argv[++i]);
+             if (hilos < 1 || hilos > MAX_HILOS) {
+                 printf("El numero de hilos debe estar entre 1 y %d\n", MAX_HILOS);
+                 return 1;
+             }
+         } else {
+             printf("Opcion desconocida: %s\n", argv[i]);
+             mostrarUso(programa);
+             return 1;
+         }
+     }
+     if (usarRecursivo && (hilos > 0 || simetria)) {
+         printf("El motor original no se puede combinar con --threads ni --simetria\n");
+         return 1;
+     }
+     if (motorRecursivoBits && hilos > 0) {
+         printf("--motor solo aplica a la busqueda secuencial\n");
+         return 1;
+     }
+     // Al reanudar se sigue guardando en el mismo archivo, salvo que se pida otro
+     if (archivoPuntoControl == NULL) {
+         archivoPuntoControl = archivoReanudar;
+     }
+     if (estimar && (usarRecursivo || motorRecursivoBits || archivoPuntoControl != NULL)) {
+         printf("--estimate mide el motor iterativo y no usa puntos de control\n");
+         return 1;
+     }
+     if (archivoSalida != NULL && (usarRecursivo || motorRecursivoBits || megasTabla > 0 || archivoPuntoControl != NULL)) {
+         // La tabla salta subarboles sin recorrerlos y al reanudar se repetirian permutaciones
+         printf("--salida requiere el motor iterativo, sin --memo ni puntos de control\n");
+         return 1;
+     }
+     if (progresoJson && intervaloProgreso == 0) {
+         intervaloProgreso = INTERVALO_PROGRESO;
+     }
+     if (intervaloProgreso > 0 && (usarRecursivo || motorRecursivoBits || estimar || listar > 0)) {
+         // Solo los hilos del ejecutor publican su avance
+         printf("--progreso requiere el motor iterativo, sin --estimate ni --listar\n");
+         return 1;
+     }
+     int usarEjecutor = hilos > 0 || archivoPuntoControl != NULL || fragmentos > 1 || intervaloProgreso > 0;
+     if (listar > 0 && (usarEjecutor || usarRecursivo || motorRecursivoBits || simetria || megasTabla > 0 ||
+                        archivoSalida != NULL || estimar)) {
+         printf("--listar no se combina con otras opciones de busqueda\n");
+         return 1;
+     }
+     if ((usarEjecutor || megasTabla > 0) && (usarRecursivo || motorRecursivoBits)) {
+         printf("Los puntos de control, --shard y --memo requieren el motor iterativo\n");
+         return 1;
+     }
+#ifndef INSTRUMENTAR
+     if (archivoInforme != NULL) {
+         printf("--informe requiere compilar con -DINSTRUMENTAR\n");
+         return 1;
+     }
+#endif
+     if (archivoInforme != NULL && (usarRecursivo || motorRecursivoBits || megasTabla > 0 ||
+                                    archivoReanudar != NULL || estimar || listar > 0)) {
+         // Los niveles solo cuadran con los nodos si el motor iterativo recorre todo el arbol
+         printf("--informe requiere el motor iterativo, sin --memo, --resume, --estimate ni --listar\n");
+         return 1;
+     }
+     if (rangoDesde > 0 && (usarRecursivo || motorRecursivoBits || repartoEstatico || archivoPuntoControl != NULL ||
+                            fragmentos > 1 || megasTabla > 0 || archivoSalida != NULL || listar > 0 || estimar ||
+                            archivoInforme != NULL)) {
+         printf("--range solo se combina con --threads, --simetria, --generico, --sin-simd y --progreso\n");
          return 1;
      }
      
-     int N = atoi(argv[1]);  // Convertir argumento a entero
+     int N = rangoDesde > 0 ? rangoHasta : atoi(argv[1]);  // Convertir argumento a entero
      int M = atoi(argv[2]);  // Convertir argumento a entero
  
      // Validar que los valores ingresados sean correctos
@@ -88,33 +411,294 @@
          return 1;
      }
      
-     // Declaracion de arreglos con el tamaño ingresado por el usuario
-     int arregloNumeros[N];  
-     int numerosUsados[N + 1];  
-     int diferenciasUsadas[N];  
+     unsigned long totalPermutaciones = 0;
+     unsigned long nodos = 0;
+     unsigned long nodosPrevios = 0;  // Nodos de ejecuciones anteriores, al reanudar
+     int tiempoAgotado = 0;
+     int errorPuntoControl = 0;
+     double pesoFragmento = 1;  // Parte del arbol que le toca a esta ejecucion
+     unsigned long consultasTabla = 0;
+     unsigned long aciertosTabla = 0;
+     double fraccion = -1;  // Negativa si el motor no la estima
+     estadisticaHilo_t porHilo[MAX_HILOS];
+ 
+     iniciarCancelacion(&cancelacion, M * 60.0);  // Guardar el tiempo de inicio
+     signal(SIGINT, manejarInterrupcion);
  
-     // Inicializar arreglos con ceros
-     for (int i = 0; i <= N; i++) {
-         numerosUsados[i] = 0;
+     parametrosBusqueda_t parametros;
+     parametros.N = N;
+     parametros.simetria = simetria;
+     parametros.cancelacion = &cancelacion;
+     parametros.tabla = NULL;
+     parametros.nucleoGenerico = nucleoGenerico;
+     parametros.sinSimd = sinSimd;
+     parametros.sinPropagacion = sinPropagacion;
+     parametros.salida = NULL;
+ 
+     if (rangoDesde > 0) {
+         // Sin --threads, un solo hilo que pasa de un N al siguiente
+         return contarRango(&parametros, rangoDesde, rangoHasta, hilos > 0 ? hilos : 1,
+                            intervaloProgreso, progresoJson);
      }
-     for (int i = 0; i < N; i++) {
-         diferenciasUsadas[i] = 0;
+ 
+     if (listar > 0) {
+         // Generador perezoso: solo se recorre hasta la ultima permutacion pedida
+         generadorGracil_t generador;
+         int permutacion[N_MAXIMO];
+         long mostradas = 0;
+         crearGenerador(&generador, N, NULL, 0);
+         while (mostradas < listar && siguienteGracil(&generador, permutacion)) {
+             for (int j = 0; j < N; j++) {
+                 printf(j > 0 ? " %d" : "%d", permutacion[j]);
+             }
+             printf("\n");
+             mostradas++;
+         }
+         printf("Permutaciones mostradas: %ld en %.6f segundos\n", mostradas, tiempoTranscurrido(&cancelacion));
+         return 0;
      }
  
-     unsigned long totalPermutaciones = 0;
-     clock_t tiempoInicio = clock();  // Guardar el tiempo de inicio
+     if (estimar) {
+         estimacionArbol_t estimacion;
+         printf("Cantidad de numeros ingresada: %d\n", N);
+         estimarArbol(&parametros, &estimacion);
+         mostrarEstimacion(&estimacion, hilos, fragmentos);
+         return 0;
+     }
  
-     encontrarPermutaciones(0, N, arregloNumeros, numerosUsados, diferenciasUsadas, &totalPermutaciones, tiempoInicio, M);
+     tablaTransposicion_t tabla;
+     if (megasTabla > 0) {
+         if (crearTabla(&tabla, (size_t)megasTabla) != 0) {
+             printf("No hay memoria para una tabla de %ld MiB\n", megasTabla);
+             return 1;
+         }
+         parametros.tabla = &tabla;
+     }
+     archivoSalida_t salida;
+     if (archivoSalida != NULL) {
+         if (abrirSalida(&salida, archivoSalida, N) != 0) {
+             printf("No se pudo crear el archivo de salida %s\n", archivoSalida);
+             return 1;
+         }
+         parametros.salida = &salida;
+     }
  
-     double tiempoTotal = (double)(clock() - tiempoInicio) / CLOCKS_PER_SEC;
+     // Los contadores heredan a los hilos creados despues de abrirlos
+     contadoresHardware_t contadores;
+     if (archivoInforme != NULL) {
+         iniciarContadoresHardware(&contadores);
+         iniciarMuestreo();
+     }
+ 
+     if (usarRecursivo) {
+         // Declaracion de arreglos con el tamaño ingresado por el usuario
+         int arregloNumeros[N];  
+         int numerosUsados[N + 1];  
+         int diferenciasUsadas[N];  
+ 
+         // Inicializar arreglos con ceros
+         for (int i = 0; i <= N; i++) {
+             numerosUsados[i] = 0;
+         }
+         for (int i = 0; i < N; i++) {
+             diferenciasUsadas[i] = 0;
+         }
+ 
+         // El motor original mide tiempo de CPU en cada nodo
+         clock_t tiempoInicio = clock();
+         encontrarPermutaciones(0, N, arregloNumeros, numerosUsados, diferenciasUsadas, &totalPermutaciones, tiempoInicio, M);
+         tiempoAgotado = (double)(clock() - tiempoInicio) / CLOCKS_PER_SEC >= M * 60;
+     } else if (usarEjecutor) {
+         // Sin --threads, un solo hilo de trabajo para poder pausarlo
+         configEjecutor_t config;
+         config.hilos = hilos > 0 ? hilos : 1;
+         config.robar = !repartoEstatico;
+         config.archivoPuntoControl = archivoPuntoControl;
+         config.intervaloPuntoControl = intervalo;
+         config.fragmento = fragmento;
+         config.fragmentos = fragmentos;
+         config.intervaloProgreso = intervaloProgreso;
+         config.progresoJson = progresoJson;
+ 
+         resultadoBusqueda_t resultado;
+         int error;
+         if (archivoReanudar != NULL) {
+             puntoControl_t pc;
+             if (cargarPuntoControl(archivoReanudar, &pc) != 0) {
+                 printf("No se pudo leer el punto de control %s\n", archivoReanudar);
+                 return 1;
+             }
+             if (pc.N != N || pc.simetria != simetria) {
+                 printf("El punto de control es de N = %d %s --simetria\n", pc.N, pc.simetria ? "con" : "sin");
+                 liberarPuntoControl(&pc);
+                 return 1;
+             }
+             if (pc.propagacion == sinPropagacion) {
+                 printf("El punto de control es %s --sin-propagacion\n", pc.propagacion ? "sin" : "con");
+                 liberarPuntoControl(&pc);
+                 return 1;
+             }
+             // El fragmento sale del punto de control; si se indico, debe coincidir
+             if (fragmentos > 1 && (pc.fragmento != fragmento || pc.fragmentos != fragmentos)) {
+                 printf("El punto de control es del fragmento %d/%d\n", pc.fragmento, pc.fragmentos);
+                 liberarPuntoControl(&pc);
+                 return 1;
+             }
+             fragmento = config.fragmento = pc.fragmento;
+             fragmentos = config.fragmentos = pc.fragmentos;
+             memset(&resultado, 0, sizeof(resultado));
+             resultado.totalPermutaciones = pc.totalPermutaciones;
+             resultado.nodos = pc.nodos;
+             resultado.fraccionExplorada = pc.fraccionExplorada;
+             resultado.pesoFragmento = pc.pesoFragmento;
+             nodosPrevios = pc.nodos;
+             error = ejecutarTareas(&parametros, &config, pc.tareas, pc.numTareas, &resultado, porHilo);
+             liberarPuntoControl(&pc);
+         } else {
+             error = buscarEnParalelo(&parametros, &config, &resultado, porHilo);
+         }
+         if (error != 0) {
+             printf("No se pudieron crear los hilos de trabajo\n");
+             return 1;
+         }
+         totalPermutaciones = resultado.totalPermutaciones;
+         nodos = resultado.nodos;
+         tiempoAgotado = resultado.tiempoAgotado;
+         fraccion = resultado.fraccionExplorada;
+         errorPuntoControl = resultado.errorPuntoControl;
+         pesoFragmento = resultado.pesoFragmento;
+         consultasTabla = resultado.consultasTabla;
+         aciertosTabla = resultado.aciertosTabla;
+     } else {
+         busquedaBits_t busqueda;
+         bufferSalida_t bufferSalida;
+         iniciarBusquedaBits(&busqueda, &parametros);
+         if (parametros.salida != NULL) {
+             if (crearBufferSalida(&bufferSalida, parametros.salida) != 0) {
+                 printf("No hay memoria para el bloque de salida\n");
+                 return 1;
+             }
+             busqueda.salida = &bufferSalida;
+         }
+ 
+         if (motorRecursivoBits) {
+             encontrarPermutacionesBits(&busqueda, 0);
+         } else {
+             busqueda.nodos++;  // La raiz
+             CONTAR_NIVEL(&busqueda, 0, 1);
+             iniciarTarea(&busqueda, 0, candidatosBits(&busqueda, 0), 1.0);
+             completarTarea(&busqueda);
+             fraccion = fraccionExplorada(&busqueda);
+         }
+         totalPermutaciones = busqueda.totalPermutaciones;
+         nodos = busqueda.nodos;
+         consultasTabla = busqueda.consultasTabla;
+         aciertosTabla = busqueda.aciertosTabla;
+         tiempoAgotado = busqueda.tiempoAgotado;
+         if (busqueda.salida != NULL) {
+             liberarBufferSalida(busqueda.salida);
+         }
+         if (archivoInforme != NULL) {
+             registrarNiveles(&busqueda);
+         }
+     }
+     int errorSalida = parametros.salida != NULL && cerrarSalida(&salida) != 0;
+ 
+     double tiempoTotal = tiempoTranscurrido(&cancelacion);
+     int errorInforme = 0;
+     if (archivoInforme != NULL) {
+         detenerMuestreo();
+         detenerContadoresHardware(&contadores);
+         resumenInforme_t resumen;
+         resumen.N = N;
+         resumen.simetria = simetria;
+         resumen.hilos = hilos;
+         resumen.fragmento = fragmento;
+         resumen.fragmentos = fragmentos;
+         resumen.tiempoAgotado = tiempoAgotado;
+         resumen.totalPermutaciones = totalPermutaciones;
+         resumen.nodos = nodos;
+         resumen.segundos = tiempoTotal;
+         errorInforme = escribirInforme(archivoInforme, &resumen, &contadores) != 0;
+     }
      
      // Mostrar resultados
      printf("Cantidad de numeros ingresada: %d\n", N);
-     if (tiempoTotal >= M * 60) {
+     if (tiempoAgotado && interrumpido) {
+         printf("[AVISO] Busqueda interrumpida por el usuario.\n");
+     } else if (tiempoAgotado) {
          printf("[AVISO] No se pudo terminar de permutar en el tiempo limite.\n");
      }
-     printf("Numero total de permutaciones graciles: %ld\n", totalPermutaciones);
+     if (tiempoAgotado) {
+         if (fraccion >= 0 && fragmentos > 1) {
+             printf("[AVISO] Conteo parcial; fragmento explorado (estimado): %.4f%%\n",
+                    pesoFragmento > 0 ? 100.0 * fraccion / pesoFragmento : 100.0);
+         } else if (fraccion >= 0) {
+             printf("[AVISO] Conteo parcial; arbol explorado (estimado): %.4f%%\n", 100.0 * fraccion);
+         }
+     }
+     if (errorPuntoControl) {
+         printf("[AVISO] No se pudo guardar el punto de control en %s\n", archivoPuntoControl);
+     } else if (tiempoAgotado && archivoPuntoControl != NULL) {
+         printf("Punto de control guardado; para continuar use --resume %s\n", archivoPuntoControl);
+     }
+     if (errorSalida) {
+         printf("[AVISO] No se pudieron escribir todas las permutaciones en %s\n", archivoSalida);
+     } else if (parametros.salida != NULL) {
+         printf("Permutaciones escritas en %s: %llu (%llu bloques de %u bytes)\n", archivoSalida,
+                (unsigned long long)salida.permutaciones, (unsigned long long)salida.bloques, TAM_BLOQUE_SALIDA);
+     }
+     if (errorInforme) {
+         printf("[AVISO] No se pudo escribir el informe en %s\n", archivoInforme);
+     }
+     if (fragmentos > 1) {
+         printf("Fragmento %d de %d\n", fragmento, fragmentos);
+     }
+     printf("Numero total de permutaciones graciles: %lu\n", totalPermutaciones);
      printf("Tiempo total de ejecucion: %.6f segundos\n", tiempoTotal);
+     // La velocidad es solo de esta ejecucion, aunque el conteo sea acumulado
+     unsigned long nodosEjecucion = nodos - nodosPrevios;
+     if (!usarRecursivo && tiempoTotal > 0) {
+         printf("Nodos explorados: %lu (%.0f nodos/s)\n", nodos, nodosEjecucion / tiempoTotal);
+     }
+     if (!usarRecursivo && !motorRecursivoBits) {
+         printf("Conteo de hojas: %s\n", nombreContadorHojas(elegirContadorHojas(!sinSimd)));
+     }
+     if (parametros.tabla != NULL) {
+         printf("Tabla de transposicion: %.1f MiB, %lu consultas, %lu aciertos (%.1f%%)\n",
+                bytesTabla(&tabla) / 1048576.0, consultasTabla, aciertosTabla,
+                consultasTabla > 0 ? 100.0 * aciertosTabla / consultasTabla : 0.0);
+         liberarTabla(&tabla);
+     }
+ 
+     // Balance de carga entre hilos
+     for (int i = 0; i < hilos; i++) {
+         printf("  Hilo %3d: %lu nodos (%.1f%%), %lu tareas\n", i, porHilo[i].nodos,
+                nodosEjecucion > 0 ? 100.0 * porHilo[i].nodos / nodosEjecucion : 0.0, porHilo[i].tareas);
+     }
+ 
+     // Cada fragmento deja su resultado para combinarlo con --merge
+     if (fragmentos > 1) {
+         char nombre[64];
+         if (archivoResultado == NULL) {
+             snprintf(nombre, sizeof(nombre), "fragmento_N%d_%d_de_%d.txt", N, fragmento, fragmentos);
+             archivoResultado = nombre;
+         }
+         resultadoFragmento_t r;
+         r.N = N;
+         r.simetria = simetria;
+         r.propagacion = !sinPropagacion;
+         r.fragmento = fragmento;
+         r.fragmentos = fragmentos;
+         r.totalPermutaciones = totalPermutaciones;
+         r.nodos = nodos;
+         r.completo = !tiempoAgotado;
+         if (guardarResultadoFragmento(archivoResultado, &r) != 0) {
+             printf("No se pudo guardar el resultado en %s\n", archivoResultado);
+             return 1;
+         }
+         printf("Resultado del fragmento guardado en %s\n", archivoResultado);
+     }
      
      return 0;
  }
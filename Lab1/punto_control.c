@@ -0,0 +1,190 @@
+/**
+ * @file punto_control.c
+ * @brief Implementación de la lectura y escritura de puntos de control.
+ *
+ * Formato (versión 3):
+ * - Firma "GRACPC" y versión, 8 bytes.
+ * - N, simetría, poda por diferencias grandes, fragmento, número de
+ *   fragmentos y número de tareas (uint32_t cada uno).
+ * - Permutaciones y nodos (uint64_t), fracción explorada y peso del
+ *   fragmento (double).
+ * - Por tarea: longitud (uint8_t), candidatos (uint64_t), peso (double) y
+ *   `longitud` bytes con los valores del prefijo.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <io.h>
+#define fsync _commit
+#else
+#include <unistd.h>
+#endif
+
+#include "punto_control.h"
+
+#define FIRMA "GRACPC"
+#define VERSION_PUNTO_CONTROL 3
+
+// Escribe un campo; acumula el error en *ok para revisar una sola vez al final
+static void escribir(FILE *f, const void *dato, size_t tam, int *ok) {
+    if (*ok && tam > 0 && fwrite(dato, tam, 1, f) != 1) {
+        *ok = 0;
+    }
+}
+
+static int leer(FILE *f, void *dato, size_t tam) {
+    return fread(dato, tam, 1, f) == 1;
+}
+
+int guardarPuntoControl(const char *archivo, const puntoControl_t *pc) {
+    size_t largo = strlen(archivo);
+    char *temporal = malloc(largo + 5);
+    if (temporal == NULL) {
+        return -1;
+    }
+    memcpy(temporal, archivo, largo);
+    memcpy(temporal + largo, ".tmp", 5);
+
+    FILE *f = fopen(temporal, "wb");
+    if (f == NULL) {
+        free(temporal);
+        return -1;
+    }
+
+    int ok = 1;
+    uint8_t version[2] = {VERSION_PUNTO_CONTROL, 0};
+    uint32_t cabecera[6] = {(uint32_t)pc->N, (uint32_t)pc->simetria, (uint32_t)pc->propagacion,
+                            (uint32_t)pc->fragmento, (uint32_t)pc->fragmentos, (uint32_t)pc->numTareas};
+    uint64_t contadores[2] = {pc->totalPermutaciones, pc->nodos};
+    double fracciones[2] = {pc->fraccionExplorada, pc->pesoFragmento};
+    escribir(f, FIRMA, 6, &ok);
+    escribir(f, version, sizeof(version), &ok);
+    escribir(f, cabecera, sizeof(cabecera), &ok);
+    escribir(f, contadores, sizeof(contadores), &ok);
+    escribir(f, fracciones, sizeof(fracciones), &ok);
+
+    for (int i = 0; i < pc->numTareas; i++) {
+        const tareaBusqueda_t *tarea = &pc->tareas[i];
+        uint8_t longitud = (uint8_t)tarea->longitud;
+        uint8_t prefijo[N_MAXIMO];
+        for (int p = 0; p < tarea->longitud; p++) {
+            prefijo[p] = (uint8_t)tarea->prefijo[p];
+        }
+        escribir(f, &longitud, 1, &ok);
+        escribir(f, &tarea->candidatos, sizeof(uint64_t), &ok);
+        escribir(f, &tarea->peso, sizeof(double), &ok);
+        escribir(f, prefijo, longitud, &ok);
+    }
+
+    // Asegurar que el contenido llego al disco antes de reemplazar el anterior
+    if (fflush(f) != 0 || fsync(fileno(f)) != 0) {
+        ok = 0;
+    }
+    if (fclose(f) != 0) {
+        ok = 0;
+    }
+    if (ok && rename(temporal, archivo) != 0) {
+        ok = 0;
+    }
+    if (!ok) {
+        remove(temporal);
+    }
+    free(temporal);
+    return ok ? 0 : -1;
+}
+
+// Un prefijo es valido si sus numeros y sus diferencias no se repiten
+static int prefijoValido(const tareaBusqueda_t *tarea, int N) {
+    uint64_t mascaraNumeros = ((1ULL << N) - 1) << 1;
+    uint64_t numeros = 0;
+    uint64_t diferencias = 0;
+    for (int p = 0; p < tarea->longitud; p++) {
+        int numero = tarea->prefijo[p];
+        if (numero < 1 || numero > N || (numeros & (1ULL << numero))) {
+            return 0;
+        }
+        numeros |= 1ULL << numero;
+        if (p > 0) {
+            int diferencia = abs(numero - tarea->prefijo[p - 1]);
+            if (diferencias & (1ULL << diferencia)) {
+                return 0;
+            }
+            diferencias |= 1ULL << diferencia;
+        }
+    }
+    return tarea->candidatos != 0 && (tarea->candidatos & ~mascaraNumeros) == 0 &&
+           (tarea->candidatos & numeros) == 0;
+}
+
+int cargarPuntoControl(const char *archivo, puntoControl_t *pc) {
+    memset(pc, 0, sizeof(*pc));
+    FILE *f = fopen(archivo, "rb");
+    if (f == NULL) {
+        return -1;
+    }
+
+    char firma[6];
+    uint8_t version[2];
+    uint32_t cabecera[6];
+    uint64_t contadores[2];
+    double fracciones[2];
+    int ok = leer(f, firma, sizeof(firma)) && memcmp(firma, FIRMA, 6) == 0 &&
+             leer(f, version, sizeof(version)) && version[0] == VERSION_PUNTO_CONTROL &&
+             leer(f, cabecera, sizeof(cabecera)) &&
+             leer(f, contadores, sizeof(contadores)) &&
+             leer(f, fracciones, sizeof(fracciones));
+    if (ok) {
+        pc->N = (int)cabecera[0];
+        pc->simetria = (int)cabecera[1];
+        pc->propagacion = (int)cabecera[2];
+        pc->fragmento = (int)cabecera[3];
+        pc->fragmentos = (int)cabecera[4];
+        pc->numTareas = (int)cabecera[5];
+        pc->totalPermutaciones = contadores[0];
+        pc->nodos = contadores[1];
+        pc->fraccionExplorada = fracciones[0];
+        pc->pesoFragmento = fracciones[1];
+        ok = pc->N > 1 && pc->N <= N_MAXIMO && cabecera[1] <= 1 && cabecera[2] <= 1 && cabecera[4] >= 1 &&
+             cabecera[4] <= (1u << 24) && cabecera[3] < cabecera[4] && cabecera[5] <= (1u << 24);
+    }
+    if (ok && pc->numTareas > 0) {
+        pc->tareas = malloc((size_t)pc->numTareas * sizeof(tareaBusqueda_t));
+        ok = pc->tareas != NULL;
+    }
+
+    for (int i = 0; ok && i < pc->numTareas; i++) {
+        tareaBusqueda_t *tarea = &pc->tareas[i];
+        uint8_t longitud;
+        uint8_t prefijo[N_MAXIMO];
+        ok = leer(f, &longitud, 1) && longitud < pc->N &&
+             leer(f, &tarea->candidatos, sizeof(uint64_t)) &&
+             leer(f, &tarea->peso, sizeof(double)) &&
+             (longitud == 0 || leer(f, prefijo, longitud));
+        if (ok) {
+            tarea->longitud = longitud;
+            for (int p = 0; p < longitud; p++) {
+                tarea->prefijo[p] = prefijo[p];
+            }
+            ok = prefijoValido(tarea, pc->N);
+        }
+    }
+    fclose(f);
+
+    if (!ok) {
+        liberarPuntoControl(pc);
+        return -1;
+    }
+    return 0;
+}
+
+void liberarPuntoControl(puntoControl_t *pc) {
+    free(pc->tareas);
+    pc->tareas = NULL;
+    pc->numTareas = 0;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file punto_control.h
+ * @brief Puntos de control para continuar una búsqueda larga en otra ejecución.
+ *
+ * Un punto de control guarda los contadores parciales y la frontera de la
+ * búsqueda como una lista de tareas pendientes (prefijo, candidatos y peso).
+ * El archivo es binario y compacto: cada valor del prefijo ocupa un byte.
+ * Los enteros y reales se guardan en el orden de bytes del equipo, así que
+ * el archivo se debe reanudar en una máquina de la misma arquitectura.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#ifndef PUNTO_CONTROL_H
+#define PUNTO_CONTROL_H
+
+#include "busqueda.h"
+
+#define INTERVALO_PUNTO_CONTROL 300.0 ///< Segundos entre puntos de control por defecto.
+
+/**
+ * @brief Estado guardado de una búsqueda.
+ */
+typedef struct {
+    int N;                            ///< Tamaño del conjunto de números.
+    int simetria;                     ///< 1 si se cuentan solo representantes canónicos.
+    int propagacion;                  ///< 1 si se poda con las diferencias grandes.
+    int fragmento;                    ///< Fragmento que se está contando (0 sin --shard).
+    int fragmentos;                   ///< Número de fragmentos (1 sin --shard).
+    double pesoFragmento;             ///< Fracción del árbol que cubre el fragmento.
+    unsigned long totalPermutaciones; ///< Permutaciones encontradas hasta el punto de control.
+    unsigned long nodos;              ///< Nodos visitados hasta el punto de control.
+    double fraccionExplorada;         ///< Parte estimada del árbol ya recorrida.
+    int numTareas;                    ///< Tareas pendientes (0 si la búsqueda terminó).
+    tareaBusqueda_t *tareas;          ///< Frontera de la búsqueda.
+} puntoControl_t;
+
+/**
+ * @brief Escribe un punto de control de forma atómica.
+ *
+ * Primero escribe un archivo temporal y luego lo renombra, así una
+ * interrupción a mitad de la escritura deja intacto el punto anterior.
+ *
+ * @param archivo Ruta del punto de control.
+ * @param pc Estado a guardar.
+ * @return int 0 si se guardó, -1 si hubo un error de escritura.
+ */
+int guardarPuntoControl(const char *archivo, const puntoControl_t *pc);
+
+/**
+ * @brief Lee y valida un punto de control.
+ *
+ * Verifica la firma, la versión y que cada prefijo sea válido (números y
+ * diferencias sin repetir) para no reanudar desde un estado imposible.
+ *
+ * @param archivo Ruta del punto de control.
+ * @param pc Estado leído; sus tareas se liberan con liberarPuntoControl().
+ * @return int 0 si se leyó, -1 si no se pudo abrir o el contenido no es válido.
+ */
+int cargarPuntoControl(const char *archivo, puntoControl_t *pc);
+
+/**
+ * @brief Libera la memoria de las tareas de un punto de control.
+ *
+ * @param pc Estado leído con cargarPuntoControl().
+ */
+void liberarPuntoControl(puntoControl_t *pc);
+
+#endif
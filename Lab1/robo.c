@@ -0,0 +1,714 @@
+/**
+ * @file robo.c
+ * @brief Implementación del ejecutor de tareas con robo de trabajo.
+ *
+ * El protocolo de robo es iniciado por el ladrón: el hilo ocioso escribe su
+ * id en la solicitud de la víctima y espera en su propio buzón. La víctima
+ * revisa su solicitud entre dos rebanadas del motor iterativo (una lectura
+ * atómica relajada cada PRESUPUESTO_ROBO nodos) y responde con una
+ * tarea o con "vacío". Así el hilo ocupado nunca toma un candado y su pila
+ * solo la modifica él mismo.
+ *
+ * Los puntos de control usan el mismo lugar seguro: entre dos rebanadas, o
+ * en la espera de un hilo ocioso, cada hilo revisa si el hilo principal
+ * pidió una pausa. Mientras está en pausa sigue rechazando solicitudes de
+ * robo, así ningún ladrón queda esperando a un hilo detenido.
+ *
+ * El reporte de progreso tampoco agrega candados: cada hilo publica sus
+ * nodos, la parte explorada y las tareas terminadas en variables atómicas
+ * propias cada REBANADAS_POR_CHEQUEO rebanadas (con escrituras relajadas,
+ * sin llamadas al sistema) y el hilo principal las suma cada
+ * `intervaloProgreso` segundos.
+ *
+ * Con varios problemas (un N distinto cada uno, ver buscarRango()) cada
+ * tarea lleva el índice de su problema y el hilo reinicia su estado al
+ * tomar una de otro problema, después de guardar lo que contó en el
+ * anterior. El trabajo robado pertenece al problema de la víctima.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "busqueda.h"
+#include "instrumentacion.h"
+#include "punto_control.h"
+#include "robo.h"
+
+#define SIN_SOLICITUD -1   ///< Nadie ha pedido trabajo.
+#define CERRADO -2         ///< El hilo terminó y ya no atiende solicitudes.
+
+#define BUZON_ESPERANDO 0  ///< El ladrón espera respuesta.
+#define BUZON_ENTREGADO 1  ///< La víctima dejó una tarea en el buzón.
+#define BUZON_VACIO 2      ///< La víctima no tenía trabajo para dar.
+
+/** @brief Nodos entre dos revisiones de la solicitud de robo. */
+#define PRESUPUESTO_ROBO 256
+/** @brief Rebanadas entre dos consultas del reloj (~4096 nodos); la bandera se revisa en todas. */
+#define REBANADAS_POR_CHEQUEO (PRESUPUESTO_REBANADA / PRESUPUESTO_ROBO)
+/** @brief Espera del hilo principal entre dos revisiones del plazo del punto de control (10 ms). */
+#define ESPERA_COORDINADOR_NS 10000000L
+
+/**
+ * @brief Contadores de un hilo para un problema que ya no tiene en su estado.
+ */
+typedef struct {
+    resultadoBusqueda_t resultado; ///< Conteos de los estados anteriores del problema.
+    double segundos;               ///< Tiempo dedicado a tareas del problema.
+    double fin;                    ///< Instante en que terminó la última de sus tareas.
+} cuentaProblema_t;
+
+/**
+ * @brief Estado de un hilo de trabajo.
+ *
+ * La solicitud y el buzón los escriben otros hilos, por eso cada uno va en
+ * su propia línea de caché, separados del estado de búsqueda.
+ */
+typedef struct {
+    _Alignas(TAM_LINEA_CACHE) atomic_int solicitud; ///< Id del ladrón que pide trabajo.
+    _Alignas(TAM_LINEA_CACHE) atomic_int estadoBuzon; ///< Respuesta a la última solicitud propia.
+    tareaBusqueda_t buzon;                          ///< Tarea recibida.
+    int problemaBuzon;                              ///< Problema de la tarea recibida.
+    /** Nodos contados por el hilo, publicados para el reporte de progreso. */
+    _Alignas(TAM_LINEA_CACHE) atomic_ulong nodosPublicados;
+    _Atomic double fraccionPublicada;               ///< fraccionExplorada() del estado, publicada.
+    atomic_ulong tareasPublicadas;                  ///< Tareas terminadas, publicadas.
+    _Alignas(TAM_LINEA_CACHE) busquedaBits_t b;     ///< Estado de búsqueda propio, con su pila.
+    unsigned long tareas;           ///< Tareas resueltas (de la cola y robadas).
+    uint32_t semilla;               ///< Estado del generador para elegir víctimas.
+    int pausaVista;                 ///< Último punto de control en el que participó.
+    bufferSalida_t salida;          ///< Bloque propio de permutaciones, si se escriben.
+    int problema;                   ///< Problema al que pertenece el estado `b`.
+    unsigned long nodosAnteriores;  ///< Nodos de los estados de otros problemas.
+    cuentaProblema_t *cuentas;      ///< Contadores de cada problema, fuera del estado actual.
+} trabajadorRobo_t;
+
+/**
+ * @brief Datos compartidos del ejecutor.
+ */
+typedef struct {
+    const parametrosBusqueda_t *parametros; ///< Parámetros de cada problema.
+    int numProblemas;
+    int hilos;
+    int robar;                      ///< 0: los hilos salen al vaciarse la cola.
+    int progreso;                   ///< 1 si los hilos publican su progreso.
+    const tareaBusqueda_t *tareas;  ///< Cola inicial de tareas.
+    const int *problemas;           ///< Problema de cada tarea de la cola, o NULL si solo hay uno.
+    int numTareas;
+    trabajadorRobo_t *trabajadores;
+    /** Número del último punto de control pedido; lo leen todos en cada rebanada. */
+    _Alignas(TAM_LINEA_CACHE) atomic_int pausaPedida;
+    _Alignas(TAM_LINEA_CACHE) atomic_int siguienteTarea; ///< Índice de la próxima tarea de la cola.
+    atomic_int activos;             ///< Hilos con trabajo, incluidas entregas en curso.
+    atomic_int enPausa;             ///< Hilos detenidos en el punto de control pedido.
+    atomic_int pausaLiberada;       ///< Último punto de control ya guardado.
+    atomic_int terminados;          ///< Hilos que ya salieron.
+} ejecutorRobo_t;
+
+typedef struct {
+    ejecutorRobo_t *ejecutor;
+    int id;
+} argumentoRobo_t;
+
+// Generador xorshift para elegir victimas sin compartir estado
+static uint32_t aleatorio(uint32_t *semilla) {
+    uint32_t x = *semilla;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *semilla = x;
+}
+
+static void responderVacio(ejecutorRobo_t *ejecutor, int ladron) {
+    atomic_store_explicit(&ejecutor->trabajadores[ladron].estadoBuzon, BUZON_VACIO, memory_order_release);
+}
+
+// Un hilo sin trabajo para dar rechaza la solicitud pendiente, si hay una
+static void rechazarSolicitud(ejecutorRobo_t *ejecutor, trabajadorRobo_t *t) {
+    if (atomic_load_explicit(&t->solicitud, memory_order_relaxed) >= 0) {
+        int ladron = atomic_exchange_explicit(&t->solicitud, SIN_SOLICITUD, memory_order_acquire);
+        responderVacio(ejecutor, ladron);
+    }
+}
+
+/**
+ * @brief Atiende una solicitud de robo entre dos rebanadas de la exploración.
+ *
+ * Busca el nivel menos profundo de la pila que todavía tiene hermanos sin
+ * explorar y entrega la mitad de ellos junto con el prefijo que los precede.
+ *
+ * @param ejecutor Datos compartidos.
+ * @param t Hilo víctima.
+ */
+static void atenderSolicitud(ejecutorRobo_t *ejecutor, trabajadorRobo_t *t) {
+    int ladron = atomic_exchange_explicit(&t->solicitud, SIN_SOLICITUD, memory_order_acquire);
+    busquedaBits_t *b = &t->b;
+
+    int nivel = b->base;
+    while (nivel <= b->posicion && b->pila[nivel] == 0) {
+        nivel++;
+    }
+    if (nivel > b->posicion) {
+        responderVacio(ejecutor, ladron);
+        return;
+    }
+
+    // Entregar los candidatos altos y quedarse con la mitad baja
+    uint64_t pendientes = b->pila[nivel];
+    uint64_t entregados = pendientes;
+    for (int quedan = __builtin_popcountll(pendientes) / 2; quedan > 0; quedan--) {
+        entregados &= entregados - 1;
+    }
+    b->pila[nivel] = pendientes ^ entregados;
+    // Los subarboles de este nivel hacia arriba ya no se pueden guardar en la tabla
+    if (nivel > b->cedidoHasta) {
+        b->cedidoHasta = nivel;
+    }
+
+    tareaBusqueda_t *tarea = &ejecutor->trabajadores[ladron].buzon;
+    tarea->longitud = nivel;
+    tarea->candidatos = entregados;
+    tarea->peso = pesoHermano(b, nivel) * __builtin_popcountll(entregados);
+    b->pesoCedido += tarea->peso;
+    memcpy(tarea->prefijo, b->arregloNumeros, nivel * sizeof(int));
+    ejecutor->trabajadores[ladron].problemaBuzon = t->problema;
+
+    // El ladron queda activo antes de que la victima pueda terminar
+    atomic_fetch_add_explicit(&ejecutor->activos, 1, memory_order_relaxed);
+    atomic_store_explicit(&ejecutor->trabajadores[ladron].estadoBuzon, BUZON_ENTREGADO, memory_order_release);
+}
+
+/**
+ * @brief Detiene al hilo mientras el hilo principal guarda un punto de control.
+ *
+ * Solo se llama en lugares seguros: con la pila entre dos rebanadas o sin
+ * tarea en curso, de modo que el estado del hilo se puede leer desde afuera.
+ *
+ * @param ejecutor Datos compartidos.
+ * @param t Hilo que revisa la pausa.
+ */
+static void esperarPuntoControl(ejecutorRobo_t *ejecutor, trabajadorRobo_t *t) {
+    int pedida = atomic_load_explicit(&ejecutor->pausaPedida, memory_order_relaxed);
+    if (pedida == t->pausaVista) {
+        return;
+    }
+    t->pausaVista = pedida;
+
+    // Avisar la llegada; el release publica el estado de la pila
+    atomic_fetch_add_explicit(&ejecutor->enPausa, 1, memory_order_release);
+    while (atomic_load_explicit(&ejecutor->pausaLiberada, memory_order_acquire) < pedida) {
+        rechazarSolicitud(ejecutor, t);
+        sched_yield();
+    }
+}
+
+// Suma los contadores de un estado a un resultado
+static void sumarEstado(resultadoBusqueda_t *resultado, const busquedaBits_t *b) {
+    resultado->totalPermutaciones += b->totalPermutaciones;
+    resultado->nodos += b->nodos;
+    resultado->tiempoAgotado |= b->tiempoAgotado;
+    resultado->fraccionExplorada += fraccionExplorada(b);
+    resultado->consultasTabla += b->consultasTabla;
+    resultado->aciertosTabla += b->aciertosTabla;
+}
+
+/**
+ * @brief Prepara el estado del hilo para una tarea del problema indicado.
+ *
+ * Si el problema cambia, los contadores del estado se guardan en las
+ * cuentas del problema anterior antes de reiniciarlo.
+ *
+ * @param ejecutor Datos compartidos.
+ * @param t Hilo que va a explorar.
+ * @param problema Problema de la tarea.
+ */
+static void cambiarProblema(ejecutorRobo_t *ejecutor, trabajadorRobo_t *t, int problema) {
+    if (problema == t->problema) {
+        return;
+    }
+    sumarEstado(&t->cuentas[t->problema].resultado, &t->b);
+    t->nodosAnteriores += t->b.nodos;
+    iniciarBusquedaBits(&t->b, &ejecutor->parametros[problema]);
+    t->problema = problema;
+}
+
+// Publica el progreso del hilo; solo escrituras relajadas en sus propias variables
+static void publicarProgreso(trabajadorRobo_t *t) {
+    atomic_store_explicit(&t->nodosPublicados, t->nodosAnteriores + t->b.nodos, memory_order_relaxed);
+    atomic_store_explicit(&t->fraccionPublicada, fraccionExplorada(&t->b), memory_order_relaxed);
+}
+
+/**
+ * @brief Explora el subárbol de un prefijo atendiendo solicitudes de robo.
+ *
+ * @param ejecutor Datos compartidos.
+ * @param t Hilo que explora.
+ * @param base Posición donde empieza la tarea (el prefijo ya está fijado).
+ * @param candidatos Candidatos a probar en la posición `base`.
+ * @param peso Fracción del árbol que cubre la tarea.
+ */
+static void explorar(ejecutorRobo_t *ejecutor, trabajadorRobo_t *t, int base, uint64_t candidatos, double peso) {
+    busquedaBits_t *b = &t->b;
+    unsigned rebanadas = 0;
+    double inicio = relojMonotonico();
+
+    iniciarTarea(b, base, candidatos, peso);
+    while (avanzarBusqueda(b, PRESUPUESTO_ROBO)) {
+        if (paradaSolicitada(b->cancelacion)) {
+            b->tiempoAgotado = 1;
+            break;
+        }
+        if (++rebanadas % REBANADAS_POR_CHEQUEO == 0) {
+            if (ejecutor->progreso) {
+                publicarProgreso(t);
+            }
+            if (revisarPlazo(b->cancelacion)) {
+                b->tiempoAgotado = 1;
+                break;
+            }
+        }
+        esperarPuntoControl(ejecutor, t);
+        if (atomic_load_explicit(&t->solicitud, memory_order_relaxed) >= 0) {
+            atenderSolicitud(ejecutor, t);
+        }
+    }
+
+    cuentaProblema_t *cuenta = &t->cuentas[t->problema];
+    cuenta->fin = relojMonotonico();
+    cuenta->segundos += cuenta->fin - inicio;
+    if (ejecutor->progreso) {
+        publicarProgreso(t);
+        atomic_store_explicit(&t->tareasPublicadas, t->tareas, memory_order_relaxed);
+    }
+}
+
+// Toma y explora la siguiente tarea de la cola; devuelve 0 si ya no quedan
+static int tomarTarea(ejecutorRobo_t *ejecutor, trabajadorRobo_t *t) {
+    // Contarse activo antes de tomarla: nadie ve la cola vacia con cero activos
+    atomic_fetch_add(&ejecutor->activos, 1);
+    int indice = atomic_fetch_add(&ejecutor->siguienteTarea, 1);
+    if (indice >= ejecutor->numTareas) {
+        atomic_fetch_sub(&ejecutor->activos, 1);
+        return 0;
+    }
+
+    const tareaBusqueda_t *tarea = &ejecutor->tareas[indice];
+    t->tareas++;
+    cambiarProblema(ejecutor, t, ejecutor->problemas != NULL ? ejecutor->problemas[indice] : 0);
+    aplicarPrefijo(&t->b, tarea);
+    explorar(ejecutor, t, tarea->longitud, tarea->candidatos, tarea->peso);
+    atomic_fetch_sub(&ejecutor->activos, 1);
+    return 1;
+}
+
+// Pide trabajo a una victima al azar; devuelve 1 si recibio una tarea
+static int intentarRobo(ejecutorRobo_t *ejecutor, trabajadorRobo_t *t, int id) {
+    int victima = (int)(aleatorio(&t->semilla) % (uint32_t)(ejecutor->hilos - 1));
+    if (victima >= id) {
+        victima++;  // Nunca a si mismo
+    }
+
+    atomic_store_explicit(&t->estadoBuzon, BUZON_ESPERANDO, memory_order_relaxed);
+    int esperado = SIN_SOLICITUD;
+    if (!atomic_compare_exchange_strong_explicit(&ejecutor->trabajadores[victima].solicitud, &esperado, id,
+                                                 memory_order_release, memory_order_relaxed)) {
+        return 0;  // La victima ya atiende a otro ladron o termino
+    }
+
+    // Mientras espera, rechaza a quien le pida trabajo para no bloquear a nadie
+    int estado;
+    while ((estado = atomic_load_explicit(&t->estadoBuzon, memory_order_acquire)) == BUZON_ESPERANDO) {
+        rechazarSolicitud(ejecutor, t);
+        sched_yield();
+    }
+    return estado == BUZON_ENTREGADO;
+}
+
+static void *trabajadorRobo(void *arg) {
+    argumentoRobo_t *argumento = (argumentoRobo_t *)arg;
+    ejecutorRobo_t *ejecutor = argumento->ejecutor;
+    int id = argumento->id;
+    trabajadorRobo_t *t = &ejecutor->trabajadores[id];
+    int colaAgotada = 0;
+
+    // Desde aqui el hilo acepta solicitudes de robo
+    atomic_store_explicit(&t->solicitud, SIN_SOLICITUD, memory_order_release);
+
+    while (!t->b.tiempoAgotado) {
+        rechazarSolicitud(ejecutor, t);
+        esperarPuntoControl(ejecutor, t);
+        if (paradaSolicitada(t->b.cancelacion)) {
+            t->b.tiempoAgotado = 1;
+            break;
+        }
+        if (!colaAgotada) {
+            if (tomarTarea(ejecutor, t)) {
+                continue;
+            }
+            colaAgotada = 1;
+        }
+        if (!ejecutor->robar || atomic_load(&ejecutor->activos) == 0) {
+            break;
+        }
+        if (revisarPlazo(t->b.cancelacion)) {
+            t->b.tiempoAgotado = 1;
+            break;
+        }
+        if (ejecutor->hilos == 1 || !intentarRobo(ejecutor, t, id)) {
+            sched_yield();
+            continue;
+        }
+
+        t->tareas++;
+        cambiarProblema(ejecutor, t, t->problemaBuzon);
+        aplicarPrefijo(&t->b, &t->buzon);
+        explorar(ejecutor, t, t->buzon.longitud, t->buzon.candidatos, t->buzon.peso);
+        atomic_fetch_sub_explicit(&ejecutor->activos, 1, memory_order_release);
+    }
+
+    // Cerrar el buzon; si un ladron alcanzo a pedir trabajo, responderle
+    int ladron = atomic_exchange_explicit(&t->solicitud, CERRADO, memory_order_acquire);
+    if (ladron >= 0) {
+        responderVacio(ejecutor, ladron);
+    }
+    atomic_fetch_add_explicit(&ejecutor->terminados, 1, memory_order_release);
+    return NULL;
+}
+
+// Suma los contadores de todos los hilos a los ya acumulados de cada problema
+static void sumarContadores(const ejecutorRobo_t *ejecutor, resultadoBusqueda_t *resultados) {
+    for (int i = 0; i < ejecutor->hilos; i++) {
+        const trabajadorRobo_t *t = &ejecutor->trabajadores[i];
+        for (int p = 0; p < ejecutor->numProblemas; p++) {
+            const resultadoBusqueda_t *cuenta = &t->cuentas[p].resultado;
+            resultados[p].totalPermutaciones += cuenta->totalPermutaciones;
+            resultados[p].nodos += cuenta->nodos;
+            resultados[p].tiempoAgotado |= cuenta->tiempoAgotado;
+            resultados[p].fraccionExplorada += cuenta->fraccionExplorada;
+            resultados[p].consultasTabla += cuenta->consultasTabla;
+            resultados[p].aciertosTabla += cuenta->aciertosTabla;
+        }
+        sumarEstado(&resultados[t->problema], &t->b);
+    }
+}
+
+/**
+ * @brief Guarda la frontera de la búsqueda con todos los hilos detenidos.
+ *
+ * La frontera son las tareas de la cola que nadie tomó más lo pendiente en
+ * la pila de cada hilo.
+ *
+ * @param ejecutor Datos compartidos; ningún hilo puede estar explorando.
+ * @param previo Contadores acumulados antes de esta ejecución.
+ * @param config Archivo del punto de control y fragmento que se cuenta.
+ * @return int 0 si se guardó, -1 si no.
+ */
+static int guardarFrontera(const ejecutorRobo_t *ejecutor, const resultadoBusqueda_t *previo, const configEjecutor_t *config) {
+    int siguiente = atomic_load(&ejecutor->siguienteTarea);
+    int enCola = siguiente < ejecutor->numTareas ? ejecutor->numTareas - siguiente : 0;
+    tareaBusqueda_t *frontera = malloc(((size_t)enCola + (size_t)ejecutor->hilos * N_MAXIMO) * sizeof(tareaBusqueda_t));
+    if (frontera == NULL) {
+        return -1;
+    }
+
+    int numTareas = enCola;
+    memcpy(frontera, ejecutor->tareas + ejecutor->numTareas - enCola, (size_t)enCola * sizeof(tareaBusqueda_t));
+    for (int i = 0; i < ejecutor->hilos; i++) {
+        numTareas += extraerPendientes(&ejecutor->trabajadores[i].b, frontera + numTareas);
+    }
+
+    resultadoBusqueda_t suma = *previo;
+    sumarContadores(ejecutor, &suma);
+
+    puntoControl_t pc;
+    pc.N = ejecutor->parametros->N;
+    pc.simetria = ejecutor->parametros->simetria;
+    pc.propagacion = !ejecutor->parametros->sinPropagacion;
+    pc.fragmento = config->fragmento;
+    pc.fragmentos = config->fragmentos;
+    pc.pesoFragmento = previo->pesoFragmento;
+    pc.totalPermutaciones = suma.totalPermutaciones;
+    pc.nodos = suma.nodos;
+    pc.fraccionExplorada = suma.fraccionExplorada;
+    pc.numTareas = numTareas;
+    pc.tareas = frontera;
+    int exito = guardarPuntoControl(config->archivoPuntoControl, &pc);
+    free(frontera);
+    return exito;
+}
+
+/**
+ * @brief Pausa a todos los hilos en un lugar seguro y guarda la frontera.
+ *
+ * @param ejecutor Datos compartidos.
+ * @param lanzados Hilos de trabajo que se alcanzaron a lanzar.
+ * @param config Archivo del punto de control y fragmento que se cuenta.
+ * @param resultado Contadores acumulados antes de esta ejecución.
+ * @param pedida Número de pausas pedidas hasta ahora; se incrementa.
+ */
+static void pausarYGuardar(ejecutorRobo_t *ejecutor, int lanzados, const configEjecutor_t *config, resultadoBusqueda_t *resultado, int *pedida) {
+    // Los que ya salieron no cuentan
+    atomic_store_explicit(&ejecutor->pausaPedida, ++*pedida, memory_order_relaxed);
+    while (atomic_load_explicit(&ejecutor->enPausa, memory_order_acquire) +
+           atomic_load_explicit(&ejecutor->terminados, memory_order_acquire) < lanzados) {
+        sched_yield();
+    }
+    if (guardarFrontera(ejecutor, resultado, config) != 0) {
+        resultado->errorPuntoControl = 1;
+    }
+    atomic_store_explicit(&ejecutor->enPausa, 0, memory_order_relaxed);
+    atomic_store_explicit(&ejecutor->pausaLiberada, *pedida, memory_order_release);
+}
+
+/**
+ * @brief Imprime en stderr una línea de progreso con lo publicado por los hilos.
+ *
+ * Solo lee las variables atómicas de cada hilo, sin detenerlos. Con un
+ * solo problema calcula la parte recorrida y el tiempo restante a partir
+ * de la velocidad media desde el inicio; con varios problemas las partes
+ * no se pueden sumar y solo informa nodos y tareas.
+ *
+ * @param ejecutor Datos compartidos.
+ * @param previo Contadores acumulados antes de esta ejecución.
+ * @param config Formato del reporte.
+ * @param segundos Segundos desde el inicio de esta ejecución.
+ * @param segundosIntervalo Segundos desde el reporte anterior.
+ * @param nodosAnteriores Nodos del reporte anterior; se actualiza.
+ */
+static void reportarProgreso(const ejecutorRobo_t *ejecutor, const resultadoBusqueda_t *previo, const configEjecutor_t *config, double segundos, double segundosIntervalo, unsigned long *nodosAnteriores) {
+    unsigned long nodos = 0;
+    unsigned long resueltas = 0;
+    double fraccion = 0;
+    for (int i = 0; i < ejecutor->hilos; i++) {
+        const trabajadorRobo_t *t = &ejecutor->trabajadores[i];
+        nodos += atomic_load_explicit(&t->nodosPublicados, memory_order_relaxed);
+        resueltas += atomic_load_explicit(&t->tareasPublicadas, memory_order_relaxed);
+        fraccion += atomic_load_explicit(&t->fraccionPublicada, memory_order_relaxed);
+    }
+    int tomadas = atomic_load_explicit(&ejecutor->siguienteTarea, memory_order_relaxed);
+    if (tomadas > ejecutor->numTareas) {
+        tomadas = ejecutor->numTareas;
+    }
+
+    double velocidad = segundosIntervalo > 0 ? (double)(nodos - *nodosAnteriores) / segundosIntervalo : 0;
+    double velocidadMedia = segundos > 0 ? (double)nodos / segundos : 0;
+    *nodosAnteriores = nodos;
+
+    // Parte recorrida del arbol (o del fragmento) y tiempo restante
+    int conFraccion = ejecutor->numProblemas == 1;
+    double parte = 0;
+    double restante = -1;
+    if (conFraccion) {
+        double peso = previo->pesoFragmento > 0 ? previo->pesoFragmento : 1;
+        double inicial = previo->fraccionExplorada / peso;
+        parte = (previo->fraccionExplorada + fraccion) / peso;
+        if (parte > 1) {
+            parte = 1;
+        }
+        if (parte > inicial && segundos > 0) {
+            restante = (1 - parte) * segundos / (parte - inicial);
+        }
+    }
+    unsigned long nodosTotales = nodos;
+    for (int p = 0; p < ejecutor->numProblemas; p++) {
+        nodosTotales += previo[p].nodos;
+    }
+
+    if (config->progresoJson) {
+        fprintf(stderr, "{\"segundos\": %.1f, \"nodos\": %lu, \"nodos_por_segundo\": %.0f, "
+                        "\"nodos_por_segundo_medio\": %.0f, \"tareas_tomadas\": %d, "
+                        "\"tareas_en_cola\": %d, \"tareas_resueltas\": %lu, ",
+                segundos, nodosTotales, velocidad, velocidadMedia, tomadas,
+                ejecutor->numTareas, resueltas);
+        if (conFraccion) {
+            fprintf(stderr, "\"fraccion\": %.6f, ", parte);
+        } else {
+            fprintf(stderr, "\"fraccion\": null, ");
+        }
+        if (restante >= 0) {
+            fprintf(stderr, "\"restante\": %.1f}\n", restante);
+        } else {
+            fprintf(stderr, "\"restante\": null}\n");
+        }
+    } else {
+        fprintf(stderr, "[progreso] %.1f s, %lu nodos, %.3g nodos/s (media %.3g), tareas %d/%d tomadas, %lu resueltas",
+                segundos, nodosTotales, velocidad, velocidadMedia, tomadas, ejecutor->numTareas, resueltas);
+        if (conFraccion) {
+            fprintf(stderr, ", %.2f%% recorrido", 100.0 * parte);
+        }
+        if (restante >= 0) {
+            fprintf(stderr, ", faltan ~%.0f s", restante);
+        }
+        fputc('\n', stderr);
+    }
+    fflush(stderr);
+}
+
+/**
+ * @brief Guarda puntos de control y reporta el progreso hasta que terminen todos los hilos.
+ *
+ * Corre en el hilo principal mientras los hilos de trabajo exploran; cada
+ * tarea tiene su propio intervalo y puede estar apagada.
+ *
+ * @param ejecutor Datos compartidos.
+ * @param lanzados Hilos de trabajo que se alcanzaron a lanzar.
+ * @param config Puntos de control e intervalo del reporte de progreso.
+ * @param resultado Contadores acumulados antes de esta ejecución.
+ * @param inicio Instante en que se lanzaron los hilos, de relojMonotonico().
+ */
+static void coordinar(ejecutorRobo_t *ejecutor, int lanzados, const configEjecutor_t *config, resultadoBusqueda_t *resultado, double inicio) {
+    struct timespec espera = {0, ESPERA_COORDINADOR_NS};
+    int conPuntos = config->archivoPuntoControl != NULL;
+    double siguientePunto = inicio + config->intervaloPuntoControl;
+    double siguienteReporte = inicio + config->intervaloProgreso;
+    double ultimoReporte = inicio;
+    unsigned long nodosAnteriores = 0;
+    int pedida = 0;
+
+    while (atomic_load_explicit(&ejecutor->terminados, memory_order_acquire) < lanzados) {
+        nanosleep(&espera, NULL);
+        if (paradaSolicitada(ejecutor->parametros->cancelacion)) {
+            continue;
+        }
+        double ahora = relojMonotonico();
+        if (ejecutor->progreso && ahora >= siguienteReporte) {
+            reportarProgreso(ejecutor, resultado, config, ahora - inicio, ahora - ultimoReporte, &nodosAnteriores);
+            ultimoReporte = ahora;
+            siguienteReporte = ahora + config->intervaloProgreso;
+        }
+        if (conPuntos && ahora >= siguientePunto) {
+            pausarYGuardar(ejecutor, lanzados, config, resultado, &pedida);
+            siguientePunto = relojMonotonico() + config->intervaloPuntoControl;
+        }
+    }
+}
+
+int ejecutarTareas(const parametrosBusqueda_t *parametros, const configEjecutor_t *config, const tareaBusqueda_t *tareas, int numTareas, resultadoBusqueda_t *resultado, estadisticaHilo_t *porHilo) {
+    return ejecutarProblemas(parametros, 1, config, tareas, NULL, numTareas, resultado, NULL, porHilo);
+}
+
+int ejecutarProblemas(const parametrosBusqueda_t *parametros, int numProblemas, const configEjecutor_t *config, const tareaBusqueda_t *tareas, const int *problemas, int numTareas, resultadoBusqueda_t *resultados, tiempoProblema_t *tiempos, estadisticaHilo_t *porHilo) {
+    int hilos = config->hilos;
+    int exito = 0;
+    double inicio = relojMonotonico();
+    trabajadorRobo_t *trabajadores = aligned_alloc(TAM_LINEA_CACHE, (size_t)hilos * sizeof(trabajadorRobo_t));
+    pthread_t *ids = malloc((size_t)hilos * sizeof(pthread_t));
+    argumentoRobo_t *argumentos = malloc((size_t)hilos * sizeof(argumentoRobo_t));
+    cuentaProblema_t *cuentas = calloc((size_t)hilos * numProblemas, sizeof(cuentaProblema_t));
+    if (trabajadores == NULL || ids == NULL || argumentos == NULL || cuentas == NULL) {
+        exito = -1;
+        goto liberar;
+    }
+
+    ejecutorRobo_t ejecutor;
+    ejecutor.parametros = parametros;
+    ejecutor.numProblemas = numProblemas;
+    ejecutor.hilos = hilos;
+    ejecutor.robar = config->robar;
+    ejecutor.progreso = config->intervaloProgreso > 0;
+    ejecutor.tareas = tareas;
+    ejecutor.problemas = problemas;
+    ejecutor.numTareas = numTareas;
+    ejecutor.trabajadores = trabajadores;
+    atomic_init(&ejecutor.pausaPedida, 0);
+    atomic_init(&ejecutor.siguienteTarea, 0);
+    atomic_init(&ejecutor.activos, 0);
+    atomic_init(&ejecutor.enPausa, 0);
+    atomic_init(&ejecutor.pausaLiberada, 0);
+    atomic_init(&ejecutor.terminados, 0);
+
+    memset(trabajadores, 0, (size_t)hilos * sizeof(trabajadorRobo_t));
+    for (int i = 0; i < hilos; i++) {
+        atomic_init(&trabajadores[i].solicitud, CERRADO);  // Hasta que el hilo arranque
+        atomic_init(&trabajadores[i].estadoBuzon, BUZON_ESPERANDO);
+        atomic_init(&trabajadores[i].nodosPublicados, 0);
+        atomic_init(&trabajadores[i].fraccionPublicada, 0.0);
+        atomic_init(&trabajadores[i].tareasPublicadas, 0);
+        iniciarBusquedaBits(&trabajadores[i].b, parametros);
+        trabajadores[i].semilla = 2463534242u + 7919u * (uint32_t)i;
+        trabajadores[i].cuentas = cuentas + (size_t)i * numProblemas;
+        if (parametros->salida != NULL) {
+            if (crearBufferSalida(&trabajadores[i].salida, parametros->salida) != 0) {
+                exito = -1;
+                goto liberarSalida;
+            }
+            trabajadores[i].b.salida = &trabajadores[i].salida;
+        }
+    }
+
+    // Los hilos que no se alcancen a lanzar quedan cerrados y nadie les roba
+    int lanzados = 0;
+    for (; lanzados < hilos; lanzados++) {
+        argumentos[lanzados].ejecutor = &ejecutor;
+        argumentos[lanzados].id = lanzados;
+        if (pthread_create(&ids[lanzados], NULL, trabajadorRobo, &argumentos[lanzados]) != 0) {
+            break;
+        }
+    }
+    if (lanzados == 0) {
+        exito = -1;
+        goto liberarSalida;
+    }
+    if (config->archivoPuntoControl != NULL || ejecutor.progreso) {
+        coordinar(&ejecutor, lanzados, config, resultados, inicio);
+    }
+    for (int i = 0; i < lanzados; i++) {
+        pthread_join(ids[i], NULL);
+#ifdef INSTRUMENTAR
+        registrarNiveles(&trabajadores[i].b);
+#endif
+    }
+
+    // El ultimo punto de control queda vacio si la busqueda termino
+    if (config->archivoPuntoControl != NULL &&
+        guardarFrontera(&ejecutor, resultados, config) != 0) {
+        resultados->errorPuntoControl = 1;
+    }
+    sumarContadores(&ejecutor, resultados);
+    // Los problemas con tareas que nadie alcanzo a tomar quedan incompletos
+    for (int i = atomic_load(&ejecutor.siguienteTarea); i < numTareas; i++) {
+        resultados[problemas != NULL ? problemas[i] : 0].tiempoAgotado = 1;
+    }
+    if (tiempos != NULL) {
+        memset(tiempos, 0, (size_t)numProblemas * sizeof(tiempoProblema_t));
+        for (int i = 0; i < lanzados; i++) {
+            for (int p = 0; p < numProblemas; p++) {
+                const cuentaProblema_t *cuenta = &trabajadores[i].cuentas[p];
+                tiempos[p].segundosHilos += cuenta->segundos;
+                if (cuenta->fin > 0 && cuenta->fin - inicio > tiempos[p].terminado) {
+                    tiempos[p].terminado = cuenta->fin - inicio;
+                }
+            }
+        }
+    }
+    if (porHilo != NULL) {
+        memset(porHilo, 0, (size_t)hilos * sizeof(estadisticaHilo_t));
+        for (int i = 0; i < lanzados; i++) {
+            porHilo[i].nodos = trabajadores[i].b.nodos;
+            for (int p = 0; p < numProblemas; p++) {
+                porHilo[i].nodos += trabajadores[i].cuentas[p].resultado.nodos;
+            }
+            porHilo[i].tareas = trabajadores[i].tareas;
+        }
+    }
+
+liberarSalida:
+    // Los bloques a medio llenar tambien van al archivo
+    for (int i = 0; i < hilos; i++) {
+        liberarBufferSalida(&trabajadores[i].salida);
+    }
+liberar:
+    free(cuentas);
+    free(trabajadores);
+    free(ids);
+    free(argumentos);
+    return exito;
+}
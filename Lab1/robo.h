@@ -0,0 +1,67 @@
+/**
+ * @file robo.h
+ * @brief Ejecutor de tareas con robo de trabajo (work stealing) y puntos de control.
+ *
+ * Cada hilo recorre su parte del árbol con una pila explícita de candidatos
+ * pendientes por posición. Los hilos toman tareas de una cola inicial; con
+ * robo de trabajo, un hilo sin trabajo le pide trabajo a otro hilo elegido
+ * al azar y el hilo ocupado le entrega la mitad de los hermanos sin explorar
+ * del nivel menos profundo de su pila, que es el subárbol más grande que
+ * tiene pendiente.
+ *
+ * Para guardar un punto de control el hilo principal pausa a todos los
+ * hilos entre dos rebanadas, convierte sus pilas y la cola en una lista de
+ * tareas pendientes y la escribe en disco antes de dejarlos continuar.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#ifndef ROBO_H
+#define ROBO_H
+
+#include "hilos.h"
+
+/**
+ * @brief Resuelve una lista de tareas con un grupo de hilos.
+ *
+ * La búsqueda termina cuando se resuelven todas las tareas o cuando se pide
+ * parar. Si hay archivo de puntos de control, se guarda uno cada
+ * `config->intervaloPuntoControl` segundos y otro al final: con la frontera
+ * pendiente si la búsqueda se detuvo, o vacío si terminó.
+ *
+ * @param parametros Parámetros de la búsqueda.
+ * @param config Hilos, modo de reparto y puntos de control.
+ * @param tareas Tareas iniciales; su nodo base ya está contado.
+ * @param numTareas Número de tareas iniciales.
+ * @param resultado Trae lo ya acumulado (ceros, o lo leído de un punto de
+ *        control) y se le suman los contadores de todos los hilos.
+ * @param porHilo Arreglo de `config->hilos` estadísticas a llenar, o NULL.
+ * @return int 0 si la búsqueda se pudo lanzar, -1 si no hubo memoria o hilos.
+ */
+int ejecutarTareas(const parametrosBusqueda_t *parametros, const configEjecutor_t *config, const tareaBusqueda_t *tareas, int numTareas, resultadoBusqueda_t *resultado, estadisticaHilo_t *porHilo);
+
+/**
+ * @brief Resuelve con un solo grupo de hilos las tareas de varios problemas.
+ *
+ * Igual que ejecutarTareas(), pero cada tarea de la cola pertenece a uno de
+ * `numProblemas` problemas (por ejemplo, un N distinto cada uno) y los
+ * contadores se suman por problema. Los puntos de control y la salida de
+ * permutaciones solo se admiten con un problema.
+ *
+ * @param parametros Parámetros de cada problema.
+ * @param numProblemas Número de problemas (1 o más).
+ * @param config Hilos, modo de reparto y puntos de control.
+ * @param tareas Tareas iniciales; su nodo base ya está contado.
+ * @param problemas Problema de cada tarea, o NULL si todas son del problema 0.
+ * @param numTareas Número de tareas iniciales.
+ * @param resultados Uno por problema; trae lo ya acumulado y se le suman
+ *        los contadores de los hilos.
+ * @param tiempos Uno por problema a llenar, o NULL.
+ * @param porHilo Arreglo de `config->hilos` estadísticas a llenar, o NULL.
+ * @return int 0 si la búsqueda se pudo lanzar, -1 si no hubo memoria o hilos.
+ */
+int ejecutarProblemas(const parametrosBusqueda_t *parametros, int numProblemas, const configEjecutor_t *config, const tareaBusqueda_t *tareas, const int *problemas, int numTareas, resultadoBusqueda_t *resultados, tiempoProblema_t *tiempos, estadisticaHilo_t *porHilo);
+
+#endif
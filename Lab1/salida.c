@@ -0,0 +1,110 @@
+/**
+ * @file salida.c
+ * @brief Implementación del archivo binario de permutaciones.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "salida.h"
+
+// Enteros en little-endian, sin depender del orden de la maquina
+static void ponerU32(uint8_t *destino, uint32_t valor) {
+    for (int i = 0; i < 4; i++) {
+        destino[i] = (uint8_t)(valor >> (8 * i));
+    }
+}
+
+static void ponerU64(uint8_t *destino, uint64_t valor) {
+    for (int i = 0; i < 8; i++) {
+        destino[i] = (uint8_t)(valor >> (8 * i));
+    }
+}
+
+// Escribe la cabecera del archivo en la posicion actual
+static int escribirCabecera(const archivoSalida_t *s) {
+    uint8_t cabecera[CABECERA_SALIDA] = {0};
+    memcpy(cabecera, FIRMA_SALIDA, 8);
+    ponerU32(cabecera + 8, VERSION_SALIDA);
+    ponerU32(cabecera + 12, (uint32_t)s->N);
+    ponerU32(cabecera + 16, BITS_POR_NUMERO);
+    ponerU32(cabecera + 20, s->tamRegistro);
+    ponerU32(cabecera + 24, TAM_BLOQUE_SALIDA);
+    ponerU32(cabecera + 28, s->registrosPorBloque);
+    ponerU64(cabecera + 32, s->bloques);
+    ponerU64(cabecera + 40, s->permutaciones);
+    return fwrite(cabecera, sizeof(cabecera), 1, s->archivo) == 1 ? 0 : -1;
+}
+
+int abrirSalida(archivoSalida_t *s, const char *ruta, int N) {
+    memset(s, 0, sizeof(*s));
+    s->N = N;
+    s->tamRegistro = (uint32_t)(N * BITS_POR_NUMERO + 7) / 8;
+    s->registrosPorBloque = (TAM_BLOQUE_SALIDA - CABECERA_BLOQUE) / s->tamRegistro;
+    s->archivo = fopen(ruta, "wb");
+    if (s->archivo == NULL) {
+        return -1;
+    }
+    // Los bloques ya van completos, el bufer de stdio solo agregaria una copia
+    setvbuf(s->archivo, NULL, _IONBF, 0);
+    if (escribirCabecera(s) != 0) {
+        fclose(s->archivo);
+        return -1;
+    }
+    pthread_mutex_init(&s->candado, NULL);
+    return 0;
+}
+
+int cerrarSalida(archivoSalida_t *s) {
+    // La cabecera provisional no tenia los totales
+    if (fseek(s->archivo, 0, SEEK_SET) != 0 || escribirCabecera(s) != 0) {
+        s->error = 1;
+    }
+    if (fclose(s->archivo) != 0) {
+        s->error = 1;
+    }
+    pthread_mutex_destroy(&s->candado);
+    return s->error ? -1 : 0;
+}
+
+int crearBufferSalida(bufferSalida_t *b, archivoSalida_t *s) {
+    b->archivo = s;
+    b->bloque = malloc(TAM_BLOQUE_SALIDA);
+    b->siguiente = b->bloque + CABECERA_BLOQUE;
+    b->registros = 0;
+    return b->bloque != NULL ? 0 : -1;
+}
+
+void volcarBufferSalida(bufferSalida_t *b) {
+    archivoSalida_t *s = b->archivo;
+    // Cabecera del bloque y relleno en cero, para que el archivo no dependa de la memoria
+    memset(b->bloque, 0, CABECERA_BLOQUE);
+    ponerU32(b->bloque, b->registros);
+    memset(b->siguiente, 0, (size_t)(b->bloque + TAM_BLOQUE_SALIDA - b->siguiente));
+
+    pthread_mutex_lock(&s->candado);
+    if (fwrite(b->bloque, TAM_BLOQUE_SALIDA, 1, s->archivo) != 1) {
+        s->error = 1;
+    }
+    s->bloques++;
+    s->permutaciones += b->registros;
+    pthread_mutex_unlock(&s->candado);
+
+    b->siguiente = b->bloque + CABECERA_BLOQUE;
+    b->registros = 0;
+}
+
+void liberarBufferSalida(bufferSalida_t *b) {
+    if (b->bloque == NULL) {
+        return;
+    }
+    if (b->registros > 0) {
+        volcarBufferSalida(b);
+    }
+    free(b->bloque);
+    b->bloque = NULL;
+}
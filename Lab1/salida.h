@@ -0,0 +1,159 @@
+/**
+ * @file salida.h
+ * @brief Escritura en binario de todas las permutaciones gráciles encontradas.
+ *
+ * Formato del archivo (enteros en little-endian):
+ * - Cabecera de CABECERA_SALIDA bytes: la firma "GRACPERM", versión (u32),
+ *   N (u32), bits por número (u32), bytes por permutación (u32), bytes por
+ *   bloque (u32), permutaciones por bloque (u32), número de bloques (u64)
+ *   y permutaciones totales (u64); el resto en cero.
+ * - Bloques de TAM_BLOQUE_SALIDA bytes, todos del mismo tamaño. Cada uno
+ *   empieza con el número de permutaciones que tiene (u32, más 4 bytes en
+ *   cero) y sigue con las permutaciones, de tamaño fijo.
+ *
+ * Cada permutación ocupa ceil(6N/8) bytes: el número de la posición j va en
+ * los bits 6j..6j+5, contando desde el bit 0 del primer byte. Con tamaños
+ * fijos el bloque b empieza en CABECERA_SALIDA + b * TAM_BLOQUE_SALIDA y
+ * se puede mapear en memoria y leer en paralelo, un bloque por hilo.
+ *
+ * Cada hilo llena su propio bloque en memoria y solo toma el candado del
+ * archivo para escribirlo completo, así que el orden de las permutaciones
+ * en el archivo no es el lexicográfico.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#ifndef SALIDA_H
+#define SALIDA_H
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define FIRMA_SALIDA "GRACPERM"        ///< Primeros 8 bytes del archivo.
+#define VERSION_SALIDA 1               ///< Versión del formato.
+#define CABECERA_SALIDA 64             ///< Bytes de la cabecera del archivo.
+#define CABECERA_BLOQUE 8              ///< Bytes de la cabecera de cada bloque.
+#define TAM_BLOQUE_SALIDA (1u << 20)   ///< Bytes de cada bloque (1 MiB).
+#define BITS_POR_NUMERO 6              ///< N < 64, así que cada número cabe en 6 bits.
+
+/**
+ * @brief Archivo de salida compartido por todos los hilos.
+ */
+typedef struct {
+    FILE *archivo;              ///< Archivo abierto para escribir.
+    pthread_mutex_t candado;    ///< Protege la escritura de bloques y los contadores.
+    int N;                      ///< Tamaño del conjunto de números.
+    uint32_t tamRegistro;       ///< Bytes de cada permutación.
+    uint32_t registrosPorBloque; ///< Permutaciones que caben en un bloque.
+    uint64_t bloques;           ///< Bloques escritos.
+    uint64_t permutaciones;     ///< Permutaciones escritas.
+    int error;                  ///< 1 si falló alguna escritura.
+} archivoSalida_t;
+
+/**
+ * @brief Bloque en memoria de un hilo.
+ */
+typedef struct {
+    archivoSalida_t *archivo;   ///< Archivo donde se vuelca el bloque.
+    uint8_t *bloque;            ///< TAM_BLOQUE_SALIDA bytes.
+    uint8_t *siguiente;         ///< Donde va la próxima permutación.
+    uint32_t registros;         ///< Permutaciones en el bloque.
+} bufferSalida_t;
+
+/**
+ * @brief Crea el archivo de salida con una cabecera provisional.
+ *
+ * @param s Archivo a inicializar.
+ * @param ruta Ruta del archivo.
+ * @param N Tamaño del conjunto de números.
+ * @return int 0 si se pudo crear, -1 si no.
+ */
+int abrirSalida(archivoSalida_t *s, const char *ruta, int N);
+
+/**
+ * @brief Escribe la cabecera definitiva y cierra el archivo.
+ *
+ * Todos los bloques de los hilos ya deben estar liberados.
+ *
+ * @param s Archivo abierto con abrirSalida().
+ * @return int 0 si todas las escrituras funcionaron, -1 si no.
+ */
+int cerrarSalida(archivoSalida_t *s);
+
+/**
+ * @brief Reserva el bloque en memoria de un hilo.
+ *
+ * @param b Bloque a inicializar.
+ * @param s Archivo de salida.
+ * @return int 0 si se pudo reservar, -1 si no.
+ */
+int crearBufferSalida(bufferSalida_t *b, archivoSalida_t *s);
+
+/**
+ * @brief Escribe el bloque en el archivo y lo deja vacío.
+ *
+ * @param b Bloque de un hilo.
+ */
+void volcarBufferSalida(bufferSalida_t *b);
+
+/**
+ * @brief Vuelca lo que quede en el bloque y libera su memoria.
+ *
+ * @param b Bloque de un hilo.
+ */
+void liberarBufferSalida(bufferSalida_t *b);
+
+/**
+ * @brief Agrega una permutación al bloque, volcándolo si se llena.
+ *
+ * @param b Bloque de un hilo.
+ * @param permutacion N números entre 1 y N.
+ */
+static inline void escribirPermutacion(bufferSalida_t *b, const int *permutacion) {
+    const int N = b->archivo->N;
+    uint8_t *destino = b->siguiente;
+    uint64_t acumulado = 0;
+    int bits = 0;
+    for (int j = 0; j < N; j++) {
+        acumulado |= (uint64_t)permutacion[j] << bits;
+        bits += BITS_POR_NUMERO;
+        while (bits >= 8) {
+            *destino++ = (uint8_t)acumulado;
+            acumulado >>= 8;
+            bits -= 8;
+        }
+    }
+    if (bits > 0) {
+        *destino++ = (uint8_t)acumulado;
+    }
+    b->siguiente = destino;
+    if (++b->registros == b->archivo->registrosPorBloque) {
+        volcarBufferSalida(b);
+    }
+}
+
+/**
+ * @brief Decodifica una permutación del archivo.
+ *
+ * @param registro Primer byte de la permutación.
+ * @param N Tamaño del conjunto de números.
+ * @param permutacion Donde se escriben los N números.
+ */
+static inline void leerPermutacion(const uint8_t *registro, int N, int *permutacion) {
+    uint64_t acumulado = 0;
+    int bits = 0;
+    for (int j = 0; j < N; j++) {
+        while (bits < BITS_POR_NUMERO) {
+            acumulado |= (uint64_t)*registro++ << bits;
+            bits += 8;
+        }
+        permutacion[j] = (int)(acumulado & ((1u << BITS_POR_NUMERO) - 1));
+        acumulado >>= BITS_POR_NUMERO;
+        bits -= BITS_POR_NUMERO;
+    }
+}
+
+#endif // SALIDA_H
@@ -0,0 +1,48 @@
+/**
+ * @file transposicion.c
+ * @brief Reserva y liberación de la tabla de transposición.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "transposicion.h"
+
+#define ALINEACION_TABLA (2u << 20) ///< Alineación a página grande (2 MiB).
+
+int crearTabla(tablaTransposicion_t *t, size_t megas) {
+    size_t maximo = (megas << 20) / sizeof(entradaTabla_t);
+    size_t entradas = 1;
+    while (entradas * 2 <= maximo) {
+        entradas *= 2;
+    }
+    size_t bytes = entradas * sizeof(entradaTabla_t);
+
+    void *memoria = NULL;
+    if (posix_memalign(&memoria, ALINEACION_TABLA, bytes) != 0) {
+        t->entradas = NULL;
+        return -1;
+    }
+#ifdef MADV_HUGEPAGE
+    // Con accesos al azar, las paginas grandes ahorran fallos de TLB
+    madvise(memoria, bytes, MADV_HUGEPAGE);
+#endif
+    // Las entradas en cero nunca pasan la verificacion
+    memset(memoria, 0, bytes);
+
+    t->entradas = memoria;
+    t->mascara = entradas - 1;
+    return 0;
+}
+
+void liberarTabla(tablaTransposicion_t *t) {
+    free(t->entradas);
+    t->entradas = NULL;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file transposicion.h
+ * @brief Tabla de transposición para no recorrer dos veces el mismo subárbol.
+ *
+ * Las permutaciones que completan un prefijo dependen solo del último número,
+ * de los números usados y de las diferencias usadas (la posición es la
+ * cantidad de números usados). Dos prefijos distintos con el mismo estado
+ * tienen el mismo subárbol, así que su conteo se guarda y se reutiliza.
+ *
+ * La tabla es de tamaño fijo, con reemplazo siempre (se pierden entradas) y
+ * sin candados: cada entrada guarda la clave mezclada con el valor por XOR,
+ * así una entrada escrita a medias por dos hilos a la vez no pasa la
+ * verificación y se trata como un fallo.
+ *
+ * @authors Angie Jaramillo, Juan Manuel Rivera
+ * @date 2025-03-29
+ * @version 1.0
+ */
+
+#ifndef TRANSPOSICION_H
+#define TRANSPOSICION_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Una entrada de la tabla: dos palabras de clave y el conteo.
+ */
+typedef struct {
+    _Atomic uint64_t verificacion1; ///< Primera palabra de la clave XOR valor.
+    _Atomic uint64_t verificacion2; ///< Segunda palabra de la clave XOR valor.
+    _Atomic uint64_t valor;         ///< Permutaciones del subárbol.
+} entradaTabla_t;
+
+/**
+ * @brief Tabla de transposición compartida por todos los hilos.
+ */
+typedef struct {
+    entradaTabla_t *entradas;   ///< Potencia de dos entradas.
+    uint64_t mascara;           ///< Número de entradas menos uno.
+} tablaTransposicion_t;
+
+/**
+ * @brief Reserva una tabla vacía.
+ *
+ * @param t Tabla a inicializar.
+ * @param megas Tamaño máximo en MiB; se usa la mayor potencia de dos de entradas que cabe.
+ * @return int 0 si se pudo reservar, -1 si no.
+ */
+int crearTabla(tablaTransposicion_t *t, size_t megas);
+
+/**
+ * @brief Libera la memoria de la tabla.
+ *
+ * @param t Tabla creada con crearTabla().
+ */
+void liberarTabla(tablaTransposicion_t *t);
+
+/**
+ * @brief Tamaño en bytes que ocupa la tabla.
+ *
+ * @param t Tabla creada con crearTabla().
+ * @return size_t Bytes reservados.
+ */
+static inline size_t bytesTabla(const tablaTransposicion_t *t) {
+    return (size_t)(t->mascara + 1) * sizeof(entradaTabla_t);
+}
+
+// Mezcla las dos palabras de la clave para elegir la entrada
+static inline uint64_t indiceTabla(const tablaTransposicion_t *t, uint64_t clave1, uint64_t clave2) {
+    uint64_t x = clave1 * 0x9E3779B97F4A7C15ULL ^ clave2 * 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 29;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 32;
+    return x & t->mascara;
+}
+
+/**
+ * @brief Busca el conteo guardado para un estado.
+ *
+ * @param t Tabla.
+ * @param clave1 Primera palabra de la clave (nunca 0).
+ * @param clave2 Segunda palabra de la clave.
+ * @param valor Recibe el conteo si se encontró.
+ * @return int 1 si se encontró, 0 si no.
+ */
+static inline int buscarEnTabla(const tablaTransposicion_t *t, uint64_t clave1, uint64_t clave2, uint64_t *valor) {
+    entradaTabla_t *e = &t->entradas[indiceTabla(t, clave1, clave2)];
+    uint64_t v = atomic_load_explicit(&e->valor, memory_order_relaxed);
+    if ((atomic_load_explicit(&e->verificacion1, memory_order_relaxed) ^ v) != clave1 ||
+        (atomic_load_explicit(&e->verificacion2, memory_order_relaxed) ^ v) != clave2) {
+        return 0;
+    }
+    *valor = v;
+    return 1;
+}
+
+/**
+ * @brief Guarda el conteo de un estado, reemplazando lo que hubiera en su entrada.
+ *
+ * @param t Tabla.
+ * @param clave1 Primera palabra de la clave (nunca 0).
+ * @param clave2 Segunda palabra de la clave.
+ * @param valor Permutaciones del subárbol.
+ */
+static inline void guardarEnTabla(tablaTransposicion_t *t, uint64_t clave1, uint64_t clave2, uint64_t valor) {
+    entradaTabla_t *e = &t->entradas[indiceTabla(t, clave1, clave2)];
+    atomic_store_explicit(&e->verificacion1, clave1 ^ valor, memory_order_relaxed);
+    atomic_store_explicit(&e->verificacion2, clave2 ^ valor, memory_order_relaxed);
+    atomic_store_explicit(&e->valor, valor, memory_order_relaxed);
+}
+
+#endif
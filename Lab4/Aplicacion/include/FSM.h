@@ -7,6 +7,9 @@
 #include "hardware/gpio.h"
 #include "hardware/sync.h"
 
+#include "filtros.h"
+#include "estadisticas.h"
+
 #ifndef _FSM_H_
 #define _FSM_H_
 
@@ -35,12 +38,15 @@ typedef void (*state_func_t)(void);
  * @brief Estructura para almacenar las mediciones.
  * 
  * Esta estructura contiene la información de una medición, incluyendo
- * la longitud, latitud y el nivel de ruido.
+ * la longitud, latitud, el nivel de ruido sin ponderar, el nivel con
+ * ponderación A (Leq, máximo y percentiles) y el nivel de cada octava.
  */
 typedef struct {
     double longitud;
     double latitud;
     uint8_t nivel_de_ruido;
+    resumen_ruido_t nivel_a;              // dB(A): Leq, Lmax, L10, L50 y L90
+    uint8_t bandas[N_BANDAS_OCTAVA];      // dB por octava, de 63 Hz a 8 kHz
 } medicion_t;
 
 /**
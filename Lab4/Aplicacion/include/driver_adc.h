@@ -3,7 +3,55 @@
 
 #include "pico/stdlib.h"
 
+#define ADC_CLOCK_HZ 48000000       // Reloj del ADC (clk_adc)
+#define ADC_SAMPLE_RATE_MAX 48000   // Frecuencia de muestreo maxima de la captura
+#define ADC_BLOCK_SIZE 256          // Muestras por bloque de DMA
+
 void adc_driver_init(uint adc_gpio, uint adc_input);
 uint16_t adc_read_sample(void);
 
-#endif
\ No newline at end of file
+/**
+ * @brief Inicia la captura continua del ADC por DMA.
+ *
+ * El ADC corre libre a la frecuencia pedida y llena su FIFO; dos canales de
+ * DMA encadenados pasan las muestras a dos bloques de ADC_BLOCK_SIZE
+ * alternados, sin trabajo de la CPU por muestra. Solo hay una interrupción
+ * por bloque.
+ *
+ * @param sample_rate_hz Frecuencia de muestreo (1..ADC_SAMPLE_RATE_MAX).
+ * @return true si la captura arrancó, false si la frecuencia no es válida
+ *         o no hay canales de DMA libres.
+ */
+bool adc_capture_start(uint32_t sample_rate_hz);
+
+/**
+ * @brief Detiene la captura y libera los canales de DMA.
+ */
+void adc_capture_stop(void);
+
+/**
+ * @brief Entrega el siguiente bloque completo, sin esperar.
+ *
+ * El bloque sigue siendo válido mientras el DMA llena el otro, es decir,
+ * durante ADC_BLOCK_SIZE muestras. Si el consumidor se atrasa más, los
+ * bloques intermedios se descartan y se cuentan en adc_capture_overruns().
+ *
+ * @return Puntero a ADC_BLOCK_SIZE muestras de 12 bits, o NULL si no hay
+ *         un bloque nuevo.
+ */
+const uint16_t *adc_capture_get_block(void);
+
+/**
+ * @brief Duerme la CPU hasta la próxima interrupción si no hay un bloque nuevo.
+ *
+ * Revisa con las interrupciones deshabilitadas, así no se pierde un bloque
+ * que termine justo antes de dormir. Cualquier interrupción la despierta.
+ */
+void adc_capture_wait(void);
+
+/**
+ * @brief Bloques descartados porque el consumidor no alcanzó a leerlos.
+ */
+uint32_t adc_capture_overruns(void);
+
+#endif
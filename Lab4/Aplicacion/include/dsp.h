@@ -0,0 +1,58 @@
+#ifndef DSP_H
+#define DSP_H
+
+#include "pico/stdlib.h"
+#include "filtros.h"
+#include "estadisticas.h"
+
+#define DSP_SAMPLE_RATE_HZ FILTROS_FS  // La captura corre a la frecuencia de los coeficientes
+
+/**
+ * @brief Resultado de una captura, escrito por el núcleo 1.
+ */
+typedef struct {
+    bool valido;                      // false si el ADC no pudo arrancar
+    uint8_t nivel_de_ruido;           // dB SPL sin ponderar
+    resumen_ruido_t nivel_a;          // dB(A): Leq, Lmax, L10, L50 y L90
+    uint8_t bandas[N_BANDAS_OCTAVA];  // dB por octava, de 63 Hz a 8 kHz
+    uint32_t bloques_perdidos;        // Bloques del ADC que el núcleo 1 no alcanzó a procesar
+} dsp_resultado_t;
+
+/**
+ * @brief Lanza el procesamiento de audio en el núcleo 1.
+ *
+ * El núcleo 1 es dueño del ADC, del DMA y de su interrupción, y hace el
+ * cálculo del nivel, la ponderación A, las octavas y las estadísticas. El
+ * núcleo 0 queda para el GPS, la EEPROM, el USB y el botón. Los pedidos y
+ * las respuestas pasan por la FIFO entre núcleos: una palabra por captura
+ * en cada sentido.
+ *
+ * El ADC ya debe estar inicializado con adc_driver_init().
+ */
+void dsp_init(void);
+
+/**
+ * @brief Pide al núcleo 1 una captura, sin esperar a que termine.
+ *
+ * @param muestras Número de muestras a DSP_SAMPLE_RATE_HZ.
+ */
+void dsp_iniciar_captura(uint32_t muestras);
+
+/**
+ * @brief Revisa, sin esperar, si la captura pedida terminó.
+ *
+ * @param resultado Se llena cuando la captura terminó.
+ * @return true si hay resultado (puede no ser válido), false si sigue en curso
+ *         o no hay captura pedida.
+ */
+bool dsp_captura_terminada(dsp_resultado_t *resultado);
+
+/**
+ * @brief Detiene la captura en curso y espera a que el núcleo 1 suelte el ADC.
+ *
+ * El núcleo 1 lo ve al terminar el bloque actual, a lo sumo ADC_BLOCK_SIZE
+ * muestras después. No hace nada si no hay captura en curso.
+ */
+void dsp_cancelar(void);
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef ESTADISTICAS_H
+#define ESTADISTICAS_H
+
+#include <stdint.h>
+#include "filtros.h"
+
+#define INTERVALO_MUESTRAS (FILTROS_FS / 8)  // Intervalos de 125 ms
+#define HISTOGRAMA_CLASES 1300                // Clases de 0.1 dB, de 0 a 129.9 dB
+
+/**
+ * @brief Estadísticas de nivel de una captura con memoria constante.
+ *
+ * Cada 125 ms se calcula el nivel con ponderación A del intervalo y se
+ * suma a un histograma de 0.1 dB; no se guarda la serie de niveles. Al
+ * final se leen del histograma los percentiles y del banco de filtros el
+ * nivel equivalente de toda la captura.
+ */
+typedef struct {
+    uint16_t histograma[HISTOGRAMA_CLASES];
+    uint32_t intervalos;       // Intervalos completos en el histograma
+    int32_t maximo_q8;         // Nivel del intervalo más alto, en Q8
+    uint32_t faltan;           // Muestras para cerrar el intervalo actual
+    uint64_t cuadrados_previos; // Acumulado de ponderación A al iniciar el intervalo
+    uint32_t muestras_previas;
+} estadisticas_t;
+
+/**
+ * @brief Resumen de una captura en dB enteros (0-255).
+ */
+typedef struct {
+    uint8_t leq;   // Nivel equivalente de toda la captura, dB(A)
+    uint8_t lmax;  // Intervalo de 125 ms más alto
+    uint8_t l10;   // Nivel superado el 10% del tiempo
+    uint8_t l50;   // Nivel superado la mitad del tiempo
+    uint8_t l90;   // Nivel superado el 90% del tiempo (ruido de fondo)
+} resumen_ruido_t;
+
+/**
+ * @brief Deja el histograma vacío para una nueva captura.
+ */
+void estadisticas_reiniciar(estadisticas_t *e);
+
+/**
+ * @brief Filtra un bloque y cierra los intervalos de 125 ms que termine.
+ *
+ * Reemplaza a filtros_procesar_bloque(): parte el bloque donde termina
+ * cada intervalo, así los intervalos no dependen del tamaño de bloque.
+ *
+ * @param e Estadísticas de la captura.
+ * @param f Banco de filtros de la captura (sus acumuladores no se borran).
+ * @param bloque Muestras de 12 bits del ADC.
+ * @param n Número de muestras.
+ */
+void estadisticas_procesar_bloque(estadisticas_t *e, filtros_banco_t *f, const uint16_t *bloque, uint32_t n);
+
+/**
+ * @brief Nivel superado el porcentaje dado de los intervalos, en Q8.
+ *
+ * @param porcentaje 10 para L10, 50 para L50, 90 para L90.
+ * @return int32_t Centro de la clase de 0.1 dB (0 sin intervalos).
+ */
+int32_t estadisticas_percentil_q8(const estadisticas_t *e, int porcentaje);
+
+/**
+ * @brief Calcula Leq, Lmax, L10, L50 y L90 de la captura.
+ *
+ * Leq sale de la suma de cuadrados de toda la captura, no del histograma.
+ * Un intervalo incompleto al final solo cuenta para Leq.
+ */
+void estadisticas_resumir(const estadisticas_t *e, const filtros_banco_t *f, resumen_ruido_t *r);
+
+#endif
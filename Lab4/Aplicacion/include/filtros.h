@@ -0,0 +1,98 @@
+#ifndef FILTROS_H
+#define FILTROS_H
+
+#include <stdint.h>
+
+#define FILTROS_FS 48000        // Frecuencia de muestreo para la que se generaron los coeficientes
+#define N_BANDAS_OCTAVA 8       // Octavas de 62.5 Hz a 8 kHz
+#define SECCIONES_A 3           // Biquads de la ponderacion A
+#define SECCIONES_OCTAVA 3      // Biquads del pasabanda y del pasabajos de cada octava
+#define FILTROS_BITS_ENTRADA 3  // Las cuentas del ADC entran a los filtros por 2^3
+#define FILTROS_BLOQUE_MAX 256  // Muestras que se filtran de una vez
+
+/**
+ * @brief Coeficientes de un biquad en Q14 (los a1 llegan a +-2).
+ *
+ * y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+ */
+typedef struct {
+    int16_t b0, b1, b2, a1, a2;
+} biquad_coef_t;
+
+/**
+ * @brief Estado de un biquad: muestras anteriores y error de redondeo.
+ */
+typedef struct {
+    int16_t x1, x2, y1, y2;
+    int32_t e1, e2;  // Residuos del redondeo, para la realimentación de error
+} biquad_estado_t;
+
+/**
+ * @brief Ponderación A y banco de octavas de una captura.
+ *
+ * Las octavas usan un solo pasabanda (centrado en fs/6) y un pasabajos
+ * antes de diezmar por 2: la octava de 8 kHz se filtra a 48 kHz, la de
+ * 4 kHz a 24 kHz, y así hasta la de 62.5 Hz a 375 Hz. Así los polos nunca
+ * quedan tan cerca de z = 1 que no se puedan representar en Q14, y las
+ * octavas bajas cuestan casi nada.
+ */
+typedef struct {
+    biquad_estado_t a[SECCIONES_A];
+    biquad_estado_t pasabanda[N_BANDAS_OCTAVA][SECCIONES_OCTAVA];
+    biquad_estado_t pasabajos[N_BANDAS_OCTAVA - 1][SECCIONES_OCTAVA];
+    uint8_t fase[N_BANDAS_OCTAVA - 1];           // Paridad de cada diezmado
+    uint64_t cuadrados_a;                         // Suma de cuadrados con ponderación A
+    uint32_t muestras_a;
+    uint64_t cuadrados_banda[N_BANDAS_OCTAVA];   // Suma de cuadrados de cada octava
+    uint32_t muestras_banda[N_BANDAS_OCTAVA];
+} filtros_banco_t;
+
+/** Frecuencia central nominal de cada octava, de la más baja a la más alta. */
+extern const uint16_t filtros_banda_hz[N_BANDAS_OCTAVA];
+
+/**
+ * @brief Deja los filtros en reposo y los acumuladores en cero.
+ */
+void filtros_reiniciar(filtros_banco_t *f);
+
+/**
+ * @brief Pone en cero los acumuladores sin tocar el estado de los filtros.
+ *
+ * Para medir intervalos seguidos sin que los filtros vuelvan a asentarse.
+ */
+void filtros_reiniciar_niveles(filtros_banco_t *f);
+
+/**
+ * @brief Filtra un bloque de muestras del ADC y acumula los cuadrados de cada salida.
+ *
+ * Coeficientes Q14, muestras Q15 y acumuladores de 32 bits, con
+ * realimentación de error de segundo orden en cada biquad para que el
+ * redondeo no se amplifique en los polos de baja frecuencia.
+ *
+ * @param f Banco de filtros de la captura.
+ * @param bloque Muestras de 12 bits del ADC.
+ * @param n Número de muestras.
+ */
+void filtros_procesar_bloque(filtros_banco_t *f, const uint16_t *bloque, uint32_t n);
+
+/**
+ * @brief Nivel con ponderación A en dB(A), Q8.
+ */
+int32_t filtros_nivel_a_q8(const filtros_banco_t *f);
+
+/**
+ * @brief Nivel con ponderación A de una parte de la captura, Q8.
+ *
+ * @param cuadrados Diferencia de cuadrados_a entre el final y el inicio del tramo.
+ * @param muestras Diferencia de muestras_a en el mismo tramo.
+ */
+int32_t filtros_nivel_a_tramo_q8(uint64_t cuadrados, uint32_t muestras);
+
+/**
+ * @brief Nivel de una octava en dB SPL, Q8.
+ *
+ * @param banda Índice de la octava (0: 62.5 Hz ... N_BANDAS_OCTAVA - 1: 8 kHz).
+ */
+int32_t filtros_nivel_banda_q8(const filtros_banco_t *f, int banda);
+
+#endif
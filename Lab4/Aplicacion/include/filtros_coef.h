@@ -0,0 +1,40 @@
+// Generado por tools/generar_filtros.py; no editar a mano
+#ifndef FILTROS_COEF_H
+#define FILTROS_COEF_H
+
+#include "filtros.h"
+
+#if FILTROS_FS != 48000 || N_BANDAS_OCTAVA != 8
+#error "filtros_coef.h se genero para otra frecuencia o numero de bandas"
+#endif
+
+// Ponderacion A, Q14 (b0, b1, b2, a1, a2)
+static const biquad_coef_t ponderacion_a[3] = {
+    {15520, -31040, 15520, -31030, 14667},
+    {13750, -13750, 0, -19660, 3311},
+    {10853, -8248, -2605, -19660, 3311},
+};
+
+// Correccion para que la ponderacion A de 0 dB a 1 kHz, en Q8
+#define PONDERACION_A_DB_Q8 325
+
+// Pasabanda de octava centrado en fs/6 de cada etapa, Q14
+static const biquad_coef_t octava_pasabanda[3] = {
+    {2772, 0, -2772, -3703, 10839},
+    {5934, 0, -5934, -11243, 7222},
+    {7318, 0, -7318, -20519, 12272},
+};
+
+// Pasabajos antes de cada diezmado por 2 (corte 0.19 fs), Q14
+static const biquad_coef_t octava_pasabajos[3] = {
+    {2086, 4172, 2086, -9723, 10028},
+    {4007, 8014, 4007, -7278, 3386},
+    {4251, 8502, 4251, -6355, 880},
+};
+
+// Correccion de ganancia en la frecuencia central de cada banda (62.5 Hz primero), en Q8
+static const int16_t octava_db_q8[N_BANDAS_OCTAVA] = {
+    2, 1, 1, 1, 1, 1, 0, 0
+};
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef RUIDO_H
+#define RUIDO_H
+
+#include <stdint.h>
+
+// Calibracion: dB SPL de una cuenta RMS, 20 * log10((3.3 V / 4095) / 50 uV), en Q8
+#define RUIDO_OFFSET_DB_Q8 6181
+
+/**
+ * @brief Acumuladores de una captura de ruido, alimentados bloque a bloque.
+ *
+ * Guarda solo la suma y la suma de cuadrados de las muestras, así la
+ * captura puede durar lo que sea sin guardar las muestras y el nivel queda
+ * listo apenas llega el último bloque.
+ */
+typedef struct {
+    uint64_t suma;            // Suma de las muestras
+    uint64_t suma_cuadrados;  // Suma de los cuadrados de las muestras
+    uint32_t muestras;        // Muestras acumuladas
+} ruido_acumulador_t;
+
+/**
+ * @brief Deja los acumuladores en cero para una nueva captura.
+ */
+void ruido_reiniciar(ruido_acumulador_t *acc);
+
+/**
+ * @brief Agrega un bloque de muestras de 12 bits a los acumuladores.
+ *
+ * Los cuadrados se suman en 32 bits de a 256 muestras (256 * 4095^2 cabe
+ * en 32 bits) y luego pasan a 64 bits, que en el M0+ es más barato.
+ *
+ * @param acc Acumuladores de la captura.
+ * @param bloque Muestras del ADC (0-4095).
+ * @param n Número de muestras del bloque.
+ */
+void ruido_procesar_bloque(ruido_acumulador_t *acc, const uint16_t *bloque, uint32_t n);
+
+/**
+ * @brief log2 de un entero de 64 bits en Q16.
+ *
+ * La parte entera sale del bit más alto y la fracción de una tabla de 33
+ * valores de log2(1 + m) con interpolación lineal; el error es menor a
+ * 2e-4 (menos de 0.001 dB).
+ *
+ * @param x Valor a convertir (mayor que 0).
+ * @return int32_t log2(x) en Q16.
+ */
+int32_t ruido_log2_q16(uint64_t x);
+
+/**
+ * @brief Nivel de la captura en dB SPL, en Q8 (1/256 dB), sin punto flotante.
+ *
+ * Calcula 10 * log10 de la varianza (la potencia sin la componente
+ * continua, que es el promedio de las muestras) con ruido_log2_q16() y le
+ * suma RUIDO_OFFSET_DB_Q8. Como el nivel es el logaritmo de la varianza,
+ * no hace falta sacar la raíz cuadrada.
+ *
+ * @return int32_t Nivel en Q8 (0 si no hay muestras o la señal es constante).
+ */
+int32_t ruido_nivel_q8(const ruido_acumulador_t *acc);
+
+/**
+ * @brief Nivel de la captura redondeado a dB SPL enteros (0-255).
+ */
+uint8_t ruido_nivel_db(const ruido_acumulador_t *acc);
+
+/**
+ * @brief Nivel en dB SPL (Q8) de una señal sin componente continua.
+ *
+ * Para las salidas de los filtros (ver filtros.h), que ya no tienen
+ * continua: basta la suma de cuadrados.
+ *
+ * @param suma_cuadrados Suma de los cuadrados de las muestras.
+ * @param muestras Número de muestras sumadas.
+ * @param bits Las muestras son cuentas del ADC multiplicadas por 2^bits.
+ * @return int32_t Nivel en Q8 (0 si no hay muestras o son todas cero).
+ */
+int32_t ruido_nivel_cuadrados_q8(uint64_t suma_cuadrados, uint32_t muestras, int bits);
+
+/**
+ * @brief Redondea un nivel en Q8 a dB enteros, saturado a 0-255.
+ */
+uint8_t ruido_db_entero(int32_t nivel_q8);
+
+#endif
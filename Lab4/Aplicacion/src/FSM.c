@@ -1,13 +1,15 @@
 #include "FSM.h"
 #include <stdio.h>
 #include <string.h>
-#include <math.h>
 #include "pico/stdlib.h"
 #include "driver_GPS.h"
 #include "driver_i2c.h"
 #include "driver_adc.h"
+#include "dsp.h"
 
-#define N_SAMPLES 10000
+#define CAPTURE_SECONDS 10
+#define N_SAMPLES ((uint32_t)DSP_SAMPLE_RATE_HZ * CAPTURE_SECONDS)
+#define REGISTRO_B1 8 // Bytes por medicion en el bloque 1: nivel, Leq, Lmax, L10, L50, L90 y 2 libres
 
 medicion_t medicion_actual;
 
@@ -24,7 +26,6 @@ static void state_dump(void);
 
 static state_func_t current_state;
 static struct repeating_timer pps_check;
-static struct repeating_timer adc_sample;
 
 static volatile bool button_pressed = false;
 static volatile bool capture_cancelled = false;
@@ -33,10 +34,6 @@ static int motivo_error = 0;
 static uint8_t Offset_B0 = 0; // Offset para el bloque 0 de la EEPROM
 static uint8_t Offset_B1 = 0; // Offset para el bloque 1 de la EEPROM
 
-volatile uint16_t adc_buffer[N_SAMPLES];
-volatile uint32_t adc_index = 0;
-volatile bool buffer_full = false;
-
 bool check_pps_callback(struct repeating_timer *t) {
     if (!pps_detected) {
         current_state = state_error;
@@ -48,24 +45,6 @@ bool check_pps_callback(struct repeating_timer *t) {
 
 }
 
-bool adc_sampling_callback(struct repeating_timer *t) {
-    if (current_state == state_error) {
-        return false;
-    }
-
-    if (adc_index < N_SAMPLES) {
-        uint16_t raw = adc_read_sample();
-        adc_buffer[adc_index++] = raw;
-    }
-
-    if (adc_index >= N_SAMPLES) {
-        buffer_full = true;
-        return false;  // Para detener el timer
-    }
-
-    return true;
-}
-
 void gpio_callback(uint gpio, uint32_t events) {
     if (gpio == BUTTON_PIN) {
         if (current_state == state_capturing) {
@@ -123,6 +102,7 @@ void fsm_init(void)
     gps_init();
 
     adc_driver_init(ADC_GPIO, 0);
+    dsp_init(); // El nucleo 1 procesa el audio; este queda para GPS, EEPROM y USB
 
     current_state = init_state;
 }
@@ -139,7 +119,7 @@ static void init_state(void)
 {
     while (!pps_detected)
     {
-        //esperando GPS
+        __wfi(); //esperando GPS: el PPS llega por interrupcion
     }
 
     printf("Transitioning to IDLE.\n");
@@ -206,9 +186,12 @@ static void state_capturing(void)
 
     add_repeating_timer_ms(2000, check_pps_callback, NULL, &pps_check); // Iniciar el temporizador para verificar PPS
 
+    // El nucleo 1 empieza a medir mientras este espera el fix del GPS
+    dsp_iniciar_captura(N_SAMPLES);
+
     char datos[128];
     double lat = 0.0, lon = 0.0;
-    uint8_t nivel_ruido;
+    dsp_resultado_t resultado;
 
     printf("Capturando datos del GPS...\n");
 
@@ -219,6 +202,15 @@ static void state_capturing(void)
         if (current_state == state_error)
         {
             motivo_error = 1; // Error por falta de PPS
+            dsp_cancelar();
+            return;
+        }
+        if (capture_cancelled)
+        {
+            printf("Capture cancelled by button press.\n");
+            dsp_cancelar();
+            cancel_repeating_timer(&pps_check);
+            current_state = state_error;
             return;
         }
         if (gps_read_line(datos, sizeof(datos)))
@@ -228,6 +220,8 @@ static void state_capturing(void)
                 fix_ok = gps_parse_GNRMC(datos, &lat, &lon);
                 if (!fix_ok)
                 {
+                    dsp_cancelar();
+                    cancel_repeating_timer(&pps_check);
                     current_state = state_error;
                     return;
                 }
@@ -241,50 +235,51 @@ static void state_capturing(void)
     
     printf("Lat, Lon: %.6f, %.6f\n", lat, lon);
 
-    adc_index = 0;
-    buffer_full = false;
-
-    add_repeating_timer_ms(1, adc_sampling_callback, NULL, &adc_sample); // Iniciar el temporizador para verificar PPS
-
-    while (!buffer_full) {
-        if (!pps_detected) {
+    while (!dsp_captura_terminada(&resultado)) {
+        if (current_state == state_error) {
             printf("PPS not detected, transitioning to error state.\n");
             motivo_error = 1; // Error por falta de PPS
-            cancel_repeating_timer(&adc_sample);
+            dsp_cancelar();
             cancel_repeating_timer(&pps_check);
-            current_state = state_error;
             return;
         }
         if (capture_cancelled) {
             printf("Capture cancelled by button press.\n");
-            cancel_repeating_timer(&adc_sample);
+            dsp_cancelar();
             cancel_repeating_timer(&pps_check);
             current_state = state_error;
             return;
         }
+        __wfe(); // Despierta con la respuesta del nucleo 1 o con cualquier interrupcion
     }
 
-    cancel_repeating_timer(&adc_sample);
     cancel_repeating_timer(&pps_check);
 
-    uint32_t suma = 0;
-    for (uint32_t i = 0; i < N_SAMPLES; i++) {
-        int16_t centered = adc_buffer[i] - 2048;
-        suma += centered * centered;
+    if (!resultado.valido) {
+        printf("No se pudo iniciar la captura del ADC.\n");
+        current_state = state_error;
+        return;
+    }
+    if (resultado.bloques_perdidos > 0) {
+        printf("Bloques del ADC perdidos: %lu\n", (unsigned long)resultado.bloques_perdidos);
     }
 
-    float rms = sqrtf((float)suma / N_SAMPLES);
-    float vin_rms = (rms / 4095.0f) * 3.3f;
-    float db_spl = 20.0f * log10f(vin_rms / 0.00005f);
-    nivel_ruido = (uint8_t)(db_spl + 0.5);
+    printf("Nivel de Ruido (uint8_t): %u\n", resultado.nivel_de_ruido);
 
-    printf("Nivel de Ruido (uint8_t): %u\n", nivel_ruido);
+    medicion_actual.nivel_a = resultado.nivel_a;
+    printf("LAeq: %u dB(A), LAmax: %u, LA10: %u, LA50: %u, LA90: %u\n",
+           medicion_actual.nivel_a.leq, medicion_actual.nivel_a.lmax, medicion_actual.nivel_a.l10,
+           medicion_actual.nivel_a.l50, medicion_actual.nivel_a.l90);
+    for (int i = 0; i < N_BANDAS_OCTAVA; i++) {
+        medicion_actual.bandas[i] = resultado.bandas[i];
+        printf("  Octava %u Hz: %u dB\n", filtros_banda_hz[i], medicion_actual.bandas[i]);
+    }
 
     //PPS sigue bien y los datos son validos
 
     medicion_actual.latitud = lat;
     medicion_actual.longitud = lon;
-    medicion_actual.nivel_de_ruido = nivel_ruido;
+    medicion_actual.nivel_de_ruido = resultado.nivel_de_ruido;
 
     printf("Data captured successfully. Transitioning to storing state.\n");
 
@@ -295,7 +290,14 @@ static void state_storing(void)
 {
     double lat = medicion_actual.latitud;
     double lon = medicion_actual.longitud;
-    uint8_t nivel = medicion_actual.nivel_de_ruido;
+    uint8_t registro[REGISTRO_B1] = {
+        medicion_actual.nivel_de_ruido,
+        medicion_actual.nivel_a.leq,
+        medicion_actual.nivel_a.lmax,
+        medicion_actual.nivel_a.l10,
+        medicion_actual.nivel_a.l50,
+        medicion_actual.nivel_a.l90,
+    };
 
     uint8_t latitude_bytes[8];
     uint8_t longitud_bytes[8];
@@ -318,14 +320,14 @@ static void state_storing(void)
 
     Offset_B0 += 16;
 
-    if (!eeprom_write_nbytes(i2c0, EEPROM_BLOCK1, Offset_B1, &nivel, 1))
+    if (!eeprom_write_nbytes(i2c0, EEPROM_BLOCK1, Offset_B1, registro, REGISTRO_B1))
     {
         printf("Error escribiendo EEPROM\n");
         current_state = state_error;
         return;
     }
 
-    Offset_B1 += 1;
+    Offset_B1 += REGISTRO_B1;
 
     gpio_put(PIN_AMARILLO, false); // Apagar el LED amarillo
     printf("Data written successfully\n");
@@ -375,7 +377,7 @@ static void state_dump(void)
     printf("Dumping data...\n");
 
     uint8_t buffer_lectura[16];
-    uint8_t nivel_ruido;
+    uint8_t registro[REGISTRO_B1];
     uint8_t pos_B0 = 0;
     uint8_t pos_B1 = 0;
 
@@ -389,7 +391,7 @@ static void state_dump(void)
             return;
         }
 
-        if (!eeprom_read_nbytes(i2c0, EEPROM_BLOCK1, pos_B1, &nivel_ruido, 1))
+        if (!eeprom_read_nbytes(i2c0, EEPROM_BLOCK1, pos_B1, registro, REGISTRO_B1))
         {
             printf("Error leyendo EEPROM en pos %d\n", pos_B1);
             current_state = state_error;
@@ -401,10 +403,12 @@ static void state_dump(void)
         memcpy(&lon, buffer_lectura + 8, 8);
 
         printf("Coordenadas: %.6f, %.6f, Nivel de ruido: %d dB\n",
-               lat, lon, nivel_ruido);
+               lat, lon, registro[0]);
+        printf("  LAeq: %d dB(A), LAmax: %d, LA10: %d, LA50: %d, LA90: %d\n",
+               registro[1], registro[2], registro[3], registro[4], registro[5]);
 
         pos_B0 += 16;
-        pos_B1 += 1;
+        pos_B1 += REGISTRO_B1;
     }
 
     printf("Dump completado. Regresando a estado IDLE.\n");
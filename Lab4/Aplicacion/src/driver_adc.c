@@ -1,5 +1,16 @@
 #include "driver_adc.h"
 #include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+// Bloques que llena el DMA, uno por canal
+static uint16_t capture_blocks[2][ADC_BLOCK_SIZE] __attribute__((aligned(4)));
+static int dma_chan[2] = {-1, -1};
+
+static volatile uint32_t blocks_done = 0;  // Bloques completos desde el inicio
+static uint32_t blocks_read = 0;           // Bloques entregados al consumidor
+static uint32_t blocks_lost = 0;
 
 // Inicializa ADC y pin
 void adc_driver_init(uint adc_gpio, uint adc_input) {
@@ -10,4 +21,106 @@ void adc_driver_init(uint adc_gpio, uint adc_input) {
 
 uint16_t adc_read_sample(void) {
     return adc_read(); // Devuelve 12 bits (0-4095)
-}
\ No newline at end of file
+}
+
+// Un bloque termino: el otro canal ya sigue solo, este se rearma
+static void dma_capture_handler(void) {
+    for (int i = 0; i < 2; i++) {
+        if (dma_channel_get_irq0_status(dma_chan[i])) {
+            dma_channel_acknowledge_irq0(dma_chan[i]);
+            dma_channel_set_write_addr(dma_chan[i], capture_blocks[i], false);
+            blocks_done++;
+        }
+    }
+}
+
+bool adc_capture_start(uint32_t sample_rate_hz) {
+    if (sample_rate_hz == 0 || sample_rate_hz > ADC_SAMPLE_RATE_MAX) {
+        return false;
+    }
+    dma_chan[0] = dma_claim_unused_channel(false);
+    dma_chan[1] = dma_claim_unused_channel(false);
+    if (dma_chan[0] < 0 || dma_chan[1] < 0) {
+        adc_capture_stop();
+        return false;
+    }
+
+    // FIFO con DREQ por cada muestra, sin bit de error ni corrimiento a 8 bits
+    adc_run(false);
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_fifo_drain();
+    adc_set_clkdiv((float)ADC_CLOCK_HZ / sample_rate_hz - 1.0f); // Periodo de 1 + div ciclos
+
+    // Cada canal llena su bloque y al terminar arranca al otro
+    for (int i = 0; i < 2; i++) {
+        dma_channel_config cfg = dma_channel_get_default_config(dma_chan[i]);
+        channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+        channel_config_set_read_increment(&cfg, false);
+        channel_config_set_write_increment(&cfg, true);
+        channel_config_set_dreq(&cfg, DREQ_ADC);
+        channel_config_set_chain_to(&cfg, dma_chan[1 - i]);
+        dma_channel_configure(dma_chan[i], &cfg, capture_blocks[i], &adc_hw->fifo, ADC_BLOCK_SIZE, false);
+        dma_channel_set_irq0_enabled(dma_chan[i], true);
+    }
+
+    blocks_done = 0;
+    blocks_read = 0;
+    blocks_lost = 0;
+    irq_set_exclusive_handler(DMA_IRQ_0, dma_capture_handler);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    dma_channel_start(dma_chan[0]);
+    adc_run(true);
+    return true;
+}
+
+void adc_capture_stop(void) {
+    adc_run(false);
+    irq_set_enabled(DMA_IRQ_0, false);
+    for (int i = 0; i < 2; i++) {
+        if (dma_chan[i] >= 0) {
+            dma_channel_set_irq0_enabled(dma_chan[i], false);
+            // Encadenar el canal consigo mismo lo desencadena; asi no se rearman entre si al abortar
+            hw_write_masked(&dma_hw->ch[dma_chan[i]].al1_ctrl,
+                            (uint)dma_chan[i] << DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB,
+                            DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS);
+        }
+    }
+    for (int i = 0; i < 2; i++) {
+        if (dma_chan[i] >= 0) {
+            dma_channel_abort(dma_chan[i]);
+            dma_channel_acknowledge_irq0(dma_chan[i]);
+            dma_channel_unclaim(dma_chan[i]);
+            dma_chan[i] = -1;
+        }
+    }
+    irq_remove_handler(DMA_IRQ_0, dma_capture_handler);
+    adc_fifo_setup(false, false, 0, false, false);
+    adc_fifo_drain();
+}
+
+const uint16_t *adc_capture_get_block(void) {
+    uint32_t done = blocks_done;
+    if (done == blocks_read) {
+        return NULL;
+    }
+    // Solo el ultimo bloque completo sigue intacto
+    if (done - blocks_read > 1) {
+        blocks_lost += done - blocks_read - 1;
+        blocks_read = done - 1;
+    }
+    return capture_blocks[blocks_read++ % 2];
+}
+
+void adc_capture_wait(void) {
+    // Una interrupcion pendiente despierta a __wfi aunque esten deshabilitadas
+    uint32_t estado = save_and_disable_interrupts();
+    if (blocks_done == blocks_read) {
+        __wfi();
+    }
+    restore_interrupts(estado);
+}
+
+uint32_t adc_capture_overruns(void) {
+    return blocks_lost;
+}
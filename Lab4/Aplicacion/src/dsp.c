@@ -0,0 +1,99 @@
+#include "dsp.h"
+#include "driver_adc.h"
+#include "ruido.h"
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+
+// Respuestas del nucleo 1, una por captura
+#define DSP_FIN 1
+#define DSP_CANCELADA 2
+
+// Estado del procesamiento: solo lo toca el nucleo 1
+static ruido_acumulador_t ruido_captura;
+static filtros_banco_t filtros_captura;
+static estadisticas_t estadisticas_captura;
+
+// El nucleo 1 lo escribe antes de responder DSP_FIN; el nucleo 0 lo lee despues
+static dsp_resultado_t resultado;
+
+static volatile bool cancelar_pedido = false;
+static bool captura_en_curso = false; // Solo lo usa el nucleo 0
+
+// Corre en el nucleo 1: la interrupcion del DMA queda en este nucleo
+static uint32_t capturar(uint32_t muestras) {
+    ruido_reiniciar(&ruido_captura);
+    filtros_reiniciar(&filtros_captura);
+    estadisticas_reiniciar(&estadisticas_captura);
+
+    if (!adc_capture_start(DSP_SAMPLE_RATE_HZ)) {
+        resultado.valido = false;
+        __dmb();
+        return DSP_FIN;
+    }
+
+    while (ruido_captura.muestras < muestras) {
+        if (cancelar_pedido) {
+            adc_capture_stop();
+            return DSP_CANCELADA;
+        }
+        const uint16_t *bloque = adc_capture_get_block();
+        if (bloque == NULL) {
+            adc_capture_wait(); // Duerme hasta el siguiente bloque
+            continue;
+        }
+        uint32_t n = muestras - ruido_captura.muestras;
+        if (n > ADC_BLOCK_SIZE) {
+            n = ADC_BLOCK_SIZE;
+        }
+        ruido_procesar_bloque(&ruido_captura, bloque, n);
+        estadisticas_procesar_bloque(&estadisticas_captura, &filtros_captura, bloque, n);
+    }
+    adc_capture_stop();
+
+    resultado.valido = true;
+    resultado.nivel_de_ruido = ruido_nivel_db(&ruido_captura); // Sin punto flotante: el M0+ no tiene FPU
+    estadisticas_resumir(&estadisticas_captura, &filtros_captura, &resultado.nivel_a);
+    for (int i = 0; i < N_BANDAS_OCTAVA; i++) {
+        resultado.bandas[i] = ruido_db_entero(filtros_nivel_banda_q8(&filtros_captura, i));
+    }
+    resultado.bloques_perdidos = adc_capture_overruns();
+    __dmb(); // El resultado queda escrito antes de que el nucleo 0 vea la respuesta
+    return DSP_FIN;
+}
+
+static void nucleo1_main(void) {
+    while (true) {
+        uint32_t muestras = multicore_fifo_pop_blocking(); // Duerme (wfe) hasta el pedido
+        multicore_fifo_push_blocking(capturar(muestras));
+    }
+}
+
+void dsp_init(void) {
+    multicore_launch_core1(nucleo1_main);
+}
+
+void dsp_iniciar_captura(uint32_t muestras) {
+    cancelar_pedido = false;
+    captura_en_curso = true;
+    multicore_fifo_push_blocking(muestras);
+}
+
+bool dsp_captura_terminada(dsp_resultado_t *r) {
+    if (!captura_en_curso || !multicore_fifo_rvalid()) {
+        return false;
+    }
+    multicore_fifo_pop_blocking(); // Solo puede ser DSP_FIN: la cancelacion espera su propia respuesta
+    captura_en_curso = false;
+    __dmb();
+    *r = resultado;
+    return true;
+}
+
+void dsp_cancelar(void) {
+    if (!captura_en_curso) {
+        return;
+    }
+    cancelar_pedido = true;
+    multicore_fifo_pop_blocking(); // DSP_CANCELADA, o DSP_FIN si termino justo antes
+    captura_en_curso = false;
+}
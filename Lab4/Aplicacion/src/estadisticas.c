@@ -0,0 +1,70 @@
+#include "estadisticas.h"
+#include "ruido.h"
+#include <string.h>
+
+void estadisticas_reiniciar(estadisticas_t *e) {
+    memset(e, 0, sizeof(*e));
+    e->faltan = INTERVALO_MUESTRAS;
+}
+
+// Nivel del intervalo que acaba de terminar, al histograma
+static void cerrar_intervalo(estadisticas_t *e, const filtros_banco_t *f) {
+    int32_t nivel = filtros_nivel_a_tramo_q8(f->cuadrados_a - e->cuadrados_previos,
+                                             f->muestras_a - e->muestras_previas);
+    e->cuadrados_previos = f->cuadrados_a;
+    e->muestras_previas = f->muestras_a;
+
+    // Clase de 0.1 dB: nivel * 10 / 256, saturado al rango del histograma
+    int32_t clase = (nivel * 10) >> 8;
+    if (clase < 0) {
+        clase = 0;
+    } else if (clase >= HISTOGRAMA_CLASES) {
+        clase = HISTOGRAMA_CLASES - 1;
+    }
+    if (e->histograma[clase] < UINT16_MAX) {
+        e->histograma[clase]++;
+    }
+    if (e->intervalos == 0 || nivel > e->maximo_q8) {
+        e->maximo_q8 = nivel;
+    }
+    e->intervalos++;
+}
+
+void estadisticas_procesar_bloque(estadisticas_t *e, filtros_banco_t *f, const uint16_t *bloque, uint32_t n) {
+    while (n > 0) {
+        uint32_t tramo = (n < e->faltan) ? n : e->faltan;
+        filtros_procesar_bloque(f, bloque, tramo);
+        bloque += tramo;
+        n -= tramo;
+        e->faltan -= tramo;
+        if (e->faltan == 0) {
+            cerrar_intervalo(e, f);
+            e->faltan = INTERVALO_MUESTRAS;
+        }
+    }
+}
+
+int32_t estadisticas_percentil_q8(const estadisticas_t *e, int porcentaje) {
+    if (e->intervalos == 0) {
+        return 0;
+    }
+    // Desde arriba, hasta pasar el porcentaje de intervalos que lo superan
+    uint32_t umbral = (e->intervalos * (uint32_t)porcentaje) / 100;
+    uint32_t acumulado = 0;
+    int clase = HISTOGRAMA_CLASES - 1;
+    for (; clase > 0; clase--) {
+        acumulado += e->histograma[clase];
+        if (acumulado > umbral) {
+            break;
+        }
+    }
+    return (clase * 256 + 128) / 10;
+}
+
+void estadisticas_resumir(const estadisticas_t *e, const filtros_banco_t *f, resumen_ruido_t *r) {
+    r->leq = ruido_db_entero(filtros_nivel_a_q8(f));
+    r->lmax = ruido_db_entero(e->maximo_q8);
+    r->l10 = ruido_db_entero(estadisticas_percentil_q8(e, 10));
+    r->l50 = ruido_db_entero(estadisticas_percentil_q8(e, 50));
+    r->l90 = ruido_db_entero(estadisticas_percentil_q8(e, 90));
+}
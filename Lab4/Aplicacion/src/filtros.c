@@ -0,0 +1,115 @@
+#include "filtros.h"
+#include "filtros_coef.h"
+#include "ruido.h"
+#include <string.h>
+
+#define BITS_COEF 14
+
+const uint16_t filtros_banda_hz[N_BANDAS_OCTAVA] = {63, 125, 250, 500, 1000, 2000, 4000, 8000};
+
+// Fuera de la pila: la de cada nucleo es de solo 2 KB
+static int16_t entrada[FILTROS_BLOQUE_MAX]; // Señal de la etapa actual (se diezma en el lugar)
+static int16_t salida[FILTROS_BLOQUE_MAX];  // Copia que se filtra para cada salida
+
+// Filtra en el lugar con una seccion Q14 y realimentacion de error de segundo orden
+static void biquad_procesar(const biquad_coef_t *c, biquad_estado_t *s, int16_t *x, uint32_t n) {
+    int32_t x1 = s->x1, x2 = s->x2, y1 = s->y1, y2 = s->y2;
+    int32_t e1 = s->e1, e2 = s->e2;
+    for (uint32_t i = 0; i < n; i++) {
+        int32_t x0 = x[i];
+        int32_t acc = c->b0 * x0 + c->b1 * x1 + c->b2 * x2 - c->a1 * y1 - c->a2 * y2 + 2 * e1 - e2;
+        int32_t y0 = acc >> BITS_COEF;
+        e2 = e1;
+        e1 = acc & ((1 << BITS_COEF) - 1); // acc >> BITS_COEF redondea hacia abajo: el residuo son los bits bajos
+        if (y0 > INT16_MAX || y0 < INT16_MIN) {
+            y0 = (y0 > 0) ? INT16_MAX : INT16_MIN;
+            e1 = 0;
+        }
+        x2 = x1;
+        x1 = x0;
+        y2 = y1;
+        y1 = y0;
+        x[i] = (int16_t)y0;
+    }
+    s->x1 = (int16_t)x1;
+    s->x2 = (int16_t)x2;
+    s->y1 = (int16_t)y1;
+    s->y2 = (int16_t)y2;
+    s->e1 = e1;
+    s->e2 = e2;
+}
+
+// Filtra una copia de x con la cascada y devuelve la suma de cuadrados de la salida
+static uint64_t filtrar_copia(const biquad_coef_t *c, biquad_estado_t *s, int secciones, const int16_t *x, uint32_t n) {
+    memcpy(salida, x, n * sizeof(int16_t));
+    for (int k = 0; k < secciones; k++) {
+        biquad_procesar(&c[k], &s[k], salida, n);
+    }
+    uint64_t suma = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        suma += (uint32_t)(salida[i] * salida[i]);
+    }
+    return suma;
+}
+
+void filtros_reiniciar(filtros_banco_t *f) {
+    memset(f, 0, sizeof(*f));
+}
+
+void filtros_reiniciar_niveles(filtros_banco_t *f) {
+    f->cuadrados_a = 0;
+    f->muestras_a = 0;
+    memset(f->cuadrados_banda, 0, sizeof(f->cuadrados_banda));
+    memset(f->muestras_banda, 0, sizeof(f->muestras_banda));
+}
+
+static void procesar_tramo(filtros_banco_t *f, const uint16_t *bloque, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        entrada[i] = (int16_t)(((int32_t)(bloque[i] & 0x0FFF) - 2048) * (1 << FILTROS_BITS_ENTRADA));
+    }
+
+    f->cuadrados_a += filtrar_copia(ponderacion_a, f->a, SECCIONES_A, entrada, n);
+    f->muestras_a += n;
+
+    // De la octava mas alta a la mas baja, diezmando por 2 entre una y otra
+    for (int etapa = 0; etapa < N_BANDAS_OCTAVA && n > 0; etapa++) {
+        int banda = N_BANDAS_OCTAVA - 1 - etapa;
+        f->cuadrados_banda[banda] += filtrar_copia(octava_pasabanda, f->pasabanda[etapa], SECCIONES_OCTAVA, entrada, n);
+        f->muestras_banda[banda] += n;
+        if (etapa == N_BANDAS_OCTAVA - 1) {
+            break;
+        }
+
+        for (int k = 0; k < SECCIONES_OCTAVA; k++) {
+            biquad_procesar(&octava_pasabajos[k], &f->pasabajos[etapa][k], entrada, n);
+        }
+        uint32_t m = 0;
+        for (uint32_t i = (f->fase[etapa] & 1); i < n; i += 2) {
+            entrada[m++] = entrada[i];
+        }
+        f->fase[etapa] = (uint8_t)((f->fase[etapa] + n) & 1);
+        n = m;
+    }
+}
+
+void filtros_procesar_bloque(filtros_banco_t *f, const uint16_t *bloque, uint32_t n) {
+    while (n > 0) {
+        uint32_t tramo = (n > FILTROS_BLOQUE_MAX) ? FILTROS_BLOQUE_MAX : n;
+        procesar_tramo(f, bloque, tramo);
+        bloque += tramo;
+        n -= tramo;
+    }
+}
+
+int32_t filtros_nivel_a_q8(const filtros_banco_t *f) {
+    return filtros_nivel_a_tramo_q8(f->cuadrados_a, f->muestras_a);
+}
+
+int32_t filtros_nivel_a_tramo_q8(uint64_t cuadrados, uint32_t muestras) {
+    return ruido_nivel_cuadrados_q8(cuadrados, muestras, FILTROS_BITS_ENTRADA) + PONDERACION_A_DB_Q8;
+}
+
+int32_t filtros_nivel_banda_q8(const filtros_banco_t *f, int banda) {
+    return ruido_nivel_cuadrados_q8(f->cuadrados_banda[banda], f->muestras_banda[banda], FILTROS_BITS_ENTRADA) +
+           octava_db_q8[banda];
+}
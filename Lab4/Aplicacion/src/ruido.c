@@ -0,0 +1,94 @@
+#include "ruido.h"
+
+#define MUESTRAS_POR_SUMA_32 256 // 256 * 4095^2 < 2^32
+
+#define DIEZ_LOG10_2_Q16 197283 // 10 * log10(2) en Q16
+
+// log2(1 + i/32) en Q16, para interpolar la mantisa
+static const uint32_t tabla_log2[33] = {
+    0, 2909, 5732, 8473, 11136, 13727, 16248, 18704, 21098, 23433, 25711,
+    27936, 30109, 32234, 34312, 36346, 38336, 40286, 42196, 44068, 45904,
+    47705, 49472, 51207, 52911, 54584, 56229, 57845, 59434, 60997, 62534,
+    64047, 65536
+};
+
+void ruido_reiniciar(ruido_acumulador_t *acc) {
+    acc->suma = 0;
+    acc->suma_cuadrados = 0;
+    acc->muestras = 0;
+}
+
+void ruido_procesar_bloque(ruido_acumulador_t *acc, const uint16_t *bloque, uint32_t n) {
+    uint32_t i = 0;
+    while (i < n) {
+        uint32_t fin = (n - i > MUESTRAS_POR_SUMA_32) ? i + MUESTRAS_POR_SUMA_32 : n;
+        uint32_t suma = 0;
+        uint32_t cuadrados = 0;
+        for (; i < fin; i++) {
+            uint32_t x = bloque[i] & 0x0FFF;
+            suma += x;
+            cuadrados += x * x;
+        }
+        acc->suma += suma;
+        acc->suma_cuadrados += cuadrados;
+    }
+    acc->muestras += n;
+}
+
+int32_t ruido_log2_q16(uint64_t x) {
+    // Parte entera: posicion del bit mas alto
+    int k = 63 - __builtin_clzll(x);
+    // Mantisa sin el bit alto, alineada a 32 bits
+    uint32_t f = (k >= 32) ? (uint32_t)(x >> (k - 32)) : (uint32_t)(x << (32 - k));
+    uint32_t i = f >> 27;              // 5 bits: segmento de la tabla
+    uint32_t resto = (f >> 11) & 0xFFFF; // 16 bits: posicion dentro del segmento
+    uint32_t y = tabla_log2[i] + (((tabla_log2[i + 1] - tabla_log2[i]) * resto) >> 16);
+    return (k << 16) + (int32_t)y;
+}
+
+// dB SPL en Q8 de una potencia en cuentas^2 dada por su log2 en Q16
+static int32_t nivel_desde_log2(int32_t log2_potencia) {
+    int64_t db = ((int64_t)log2_potencia * DIEZ_LOG10_2_Q16 + (1 << 23)) >> 24; // Q16 * Q16 -> Q8
+    return (int32_t)db + RUIDO_OFFSET_DB_Q8;
+}
+
+int32_t ruido_nivel_q8(const ruido_acumulador_t *acc) {
+    uint64_t n = acc->muestras;
+    if (n == 0) {
+        return 0;
+    }
+
+    // Con la media entera q y el residuo r: S2 = suma de (x - q)^2 y
+    // varianza = S2 / n - (r / n)^2, todo en Q32 sin desbordar para cualquier n
+    uint64_t q = acc->suma / n;
+    uint64_t r = acc->suma - q * n;
+    uint64_t s2 = acc->suma_cuadrados - q * (acc->suma + r);
+    uint64_t t = (r << 32) / n;
+    uint64_t varianza = ((s2 / n) << 32) + ((s2 % n) << 32) / n - ((t * t) >> 32);
+    if (varianza == 0) {
+        return 0;
+    }
+
+    // 20 * log10(rms) = 10 * log10(varianza), asi que no hace falta la raiz
+    return nivel_desde_log2(ruido_log2_q16(varianza) - (32 << 16));
+}
+
+int32_t ruido_nivel_cuadrados_q8(uint64_t suma_cuadrados, uint32_t muestras, int bits) {
+    if (muestras == 0 || suma_cuadrados == 0) {
+        return 0;
+    }
+    // log2(suma / n) en cuentas^2: las muestras venian multiplicadas por 2^bits
+    return nivel_desde_log2(ruido_log2_q16(suma_cuadrados) - ruido_log2_q16(muestras) - (2 * bits << 16));
+}
+
+uint8_t ruido_db_entero(int32_t nivel_q8) {
+    int32_t db = (nivel_q8 + 128) >> 8; // Redondeo al dB mas cercano
+    if (db < 0) {
+        return 0;
+    }
+    return (db > 255) ? 255 : (uint8_t)db;
+}
+
+uint8_t ruido_nivel_db(const ruido_acumulador_t *acc) {
+    return ruido_db_entero(ruido_nivel_q8(acc));
+}
@@ -0,0 +1,70 @@
+// Barrido en el PC de la ponderacion A y de las octavas de filtros.c (ver CMakeLists.txt)
+#include "filtros.h"
+#include <math.h>
+#include <stdio.h>
+
+#define AMPLITUD 500.0          // Cuentas del ADC, lejos de saturar los filtros
+#define ERROR_A_MAX 0.5         // dB contra la curva exacta de IEC 61672-1
+#define ERROR_CENTRO_MAX 0.4    // Clase 1 de IEC 61260-1 en la frecuencia central
+#define ATENUACION_VECINA 16.6  // Clase 1 de IEC 61260-1 a una octava del centro
+
+static filtros_banco_t banco;
+
+// Curva analogica de la ponderacion A en dB, 0 dB en 1 kHz
+static double ponderacion_a(double f) {
+    double f2 = f * f;
+    double ra = (12194.217 * 12194.217 * f2 * f2) /
+                ((f2 + 20.598997 * 20.598997) * sqrt((f2 + 107.65265 * 107.65265) * (f2 + 737.86223 * 737.86223)) *
+                 (f2 + 12194.217 * 12194.217));
+    return 20.0 * log10(ra) + 2.0;
+}
+
+// Filtra 1 s de un seno para asentar los filtros y mide los 2 s siguientes
+static void medir_seno(double f) {
+    uint16_t bloque[FILTROS_BLOQUE_MAX];
+    long i = 0;
+    filtros_reiniciar(&banco);
+    for (int b = 0; b < 3 * FILTROS_FS / FILTROS_BLOQUE_MAX; b++) {
+        if (b == FILTROS_FS / FILTROS_BLOQUE_MAX) {
+            filtros_reiniciar_niveles(&banco);
+        }
+        for (int j = 0; j < FILTROS_BLOQUE_MAX; j++, i++) {
+            bloque[j] = (uint16_t)lround(2048.0 + AMPLITUD * sin(2.0 * M_PI * f * i / FILTROS_FS));
+        }
+        filtros_procesar_bloque(&banco, bloque, FILTROS_BLOQUE_MAX);
+    }
+}
+
+int main(void) {
+    const double frecuencias[] = {20, 31.5, 63, 125, 250, 500, 1000, 2000, 4000, 8000, 12500, 16000};
+    // Nivel del seno sin filtrar, con la calibracion de ruido.h
+    double lineal = 20.0 * log10(AMPLITUD / sqrt(2.0) / 4095.0 * 3.3 / 50e-6);
+    int fallas = 0;
+
+    printf("Ponderacion A (error contra IEC 61672-1):\n");
+    for (int k = 0; k < (int)(sizeof(frecuencias) / sizeof(frecuencias[0])); k++) {
+        medir_seno(frecuencias[k]);
+        double error = filtros_nivel_a_q8(&banco) / 256.0 - lineal - ponderacion_a(frecuencias[k]);
+        int falla = fabs(error) > ERROR_A_MAX;
+        printf("  %7.1f Hz: %+.2f dB%s\n", frecuencias[k], error, falla ? "  FALLA" : "");
+        fallas += falla;
+    }
+
+    printf("Octavas (nivel relativo en el centro y a una octava):\n");
+    for (int banda = 0; banda < N_BANDAS_OCTAVA; banda++) {
+        double centro = 8000.0 / (1 << (N_BANDAS_OCTAVA - 1 - banda));  // 62.5 Hz ... 8 kHz
+        double relativo[3];
+        for (int v = 0; v < 3; v++) {
+            medir_seno(centro * (0.5 * (1 << v)));
+            relativo[v] = filtros_nivel_banda_q8(&banco, banda) / 256.0 - lineal;
+        }
+        int falla = fabs(relativo[1]) > ERROR_CENTRO_MAX || -relativo[0] < ATENUACION_VECINA ||
+                    -relativo[2] < ATENUACION_VECINA;
+        printf("  %7.1f Hz: %+.2f dB, %+.1f dB abajo, %+.1f dB arriba%s\n", centro, relativo[1], relativo[0],
+               relativo[2], falla ? "  FALLA" : "");
+        fallas += falla;
+    }
+
+    printf(fallas == 0 ? "OK\n" : "FALLA\n");
+    return fallas == 0 ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+// Prueba en el PC de ruido.c contra el calculo en punto flotante (ver CMakeLists.txt)
+#include "ruido.h"
+#include <math.h>
+#include <stdio.h>
+
+#define ERROR_LOG2_MAX 2e-4  // Cota documentada en ruido.h
+#define ERROR_DB_MAX 0.1
+
+static uint32_t semilla = 1;
+
+// Generador congruencial propio, para que la prueba de lo mismo en cualquier PC
+static uint32_t aleatorio(void) {
+    semilla = semilla * 1103515245u + 12345u;
+    return semilla >> 8;
+}
+
+static uint64_t aleatorio_64(void) {
+    return ((uint64_t)aleatorio() << 40) ^ ((uint64_t)aleatorio() << 16) ^ aleatorio();
+}
+
+static int probar_log2(void) {
+    double peor = 0.0;
+    for (int k = 0; k < 64; k++) {
+        uint64_t base = 1ULL << k;
+        uint64_t extremos[3] = {base, base + (base - 1), base + (base >> 1)};
+        for (int j = 0; j < 20000 + 3; j++) {
+            uint64_t x = (j < 3) ? extremos[j] : base + (k ? aleatorio_64() % base : 0);
+            double error = fabs(ruido_log2_q16(x) / 65536.0 - log2((double)x));
+            if (error > peor) {
+                peor = error;
+            }
+        }
+    }
+    printf("log2: error maximo %.2e\n", peor);
+    return peor <= ERROR_LOG2_MAX;
+}
+
+// Nivel de referencia en doble precision, con la formula de calibracion
+static double nivel_referencia(uint64_t suma, uint64_t suma_cuadrados, uint32_t n) {
+    long double media = (long double)suma / n;
+    long double varianza = (long double)suma_cuadrados / n - media * media;
+    return 20.0 * log10(sqrt((double)varianza) / 4095.0 * 3.3 / 50e-6);
+}
+
+static int probar_nivel(void) {
+    const uint32_t tamanos[] = {256, 6000, 480000, 2000000};
+    const int bases[] = {300, 2048, 3800};
+    uint16_t bloque[256];
+    double peor = 0.0;
+    int casos = 0;
+    int fallas = 0;
+
+    for (int b = 0; b < 3; b++) {
+        for (int t = 0; t < 4; t++) {
+            for (double amplitud = 0.5; amplitud < 2048.0; amplitud *= 1.3) {
+                ruido_acumulador_t acc;
+                ruido_reiniciar(&acc);
+                uint64_t suma = 0, suma_cuadrados = 0;
+                uint32_t n = tamanos[t];
+                for (uint32_t i = 0; i < n;) {
+                    uint32_t m = (n - i > 256) ? 256 : n - i;
+                    for (uint32_t j = 0; j < m; j++, i++) {
+                        double u = (aleatorio() & 0xFFFF) / 65536.0 - 0.5;
+                        long v = lround(bases[b] + amplitud * 2.0 * u * sin(i * 0.3) + amplitud * 0.7 * sin(i * 0.011));
+                        v = (v < 0) ? 0 : (v > 4095 ? 4095 : v);  // Satura como el ADC
+                        bloque[j] = (uint16_t)v;
+                        suma += (uint64_t)v;
+                        suma_cuadrados += (uint64_t)(v * v);
+                    }
+                    ruido_procesar_bloque(&acc, bloque, m);
+                }
+                double error = fabs(ruido_nivel_q8(&acc) / 256.0 - nivel_referencia(suma, suma_cuadrados, n));
+                if (error > peor) {
+                    peor = error;
+                }
+                if (error > ERROR_DB_MAX) {
+                    printf("  n = %lu, base %d, amplitud %.2f: error %.3f dB\n", (unsigned long)n, bases[b],
+                           amplitud, error);
+                    fallas++;
+                }
+                casos++;
+            }
+        }
+    }
+
+    // Sin muestras o con la senal constante no hay nivel
+    ruido_acumulador_t acc;
+    ruido_reiniciar(&acc);
+    if (ruido_nivel_q8(&acc) != 0) {
+        printf("  sin muestras: nivel distinto de 0\n");
+        fallas++;
+    }
+    for (int j = 0; j < 256; j++) {
+        bloque[j] = 1234;
+    }
+    ruido_procesar_bloque(&acc, bloque, 256);
+    if (ruido_nivel_q8(&acc) != 0) {
+        printf("  senal constante: nivel distinto de 0\n");
+        fallas++;
+    }
+
+    printf("nivel: %d casos, error maximo %.4f dB\n", casos, peor);
+    return fallas == 0;
+}
+
+int main(void) {
+    int ok = probar_log2();
+    ok = probar_nivel() && ok;
+    printf(ok ? "OK\n" : "FALLA\n");
+    return ok ? 0 : 1;
+}
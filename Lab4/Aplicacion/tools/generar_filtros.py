@@ -0,0 +1,321 @@
+"""
+Genera include/filtros_coef.h: coeficientes de la ponderacion A y del
+banco de octavas para filtros.c, y los verifica contra las mascaras de
+tolerancia antes de escribirlos.
+
+- Ponderacion A: los polos analogicos de IEC 61672-1 se pasan a digital
+  con la transformada z acoplada (z = e^(sT)); los ceros en 0 Hz quedan en
+  z = 1. Se compara con las tolerancias de clase 1 de IEC 61672-1.
+- Octavas: Butterworth pasabanda de orden 3 (6 polos) con frecuencia
+  central fs/6 y pasabajos Butterworth de orden 6 antes de cada diezmado
+  por 2, asi el mismo pasabanda sirve para todas las octavas (8 kHz a
+  48 kHz, 4 kHz a 24 kHz, ..., 62.5 Hz a 375 Hz). Cada banda se compara,
+  incluyendo el aliasing de los diezmados, con los limites de clase 1 de
+  IEC 61260-1.
+
+La respuesta se calcula con los coeficientes ya cuantizados. Solo usa la
+biblioteca estandar:
+
+    python3 tools/generar_filtros.py [salida.h]
+
+Termina con error (y sin escribir) si algun filtro queda fuera de mascara.
+"""
+
+import cmath
+import math
+import sys
+
+FS = 48000
+BITS_COEF = 14          # Q14: los a1 llegan a +-2
+N_BANDAS = 8            # 62.5 Hz a 8 kHz
+ORDEN_PASABANDA = 3
+ORDEN_PASABAJOS = 6
+CORTE_PASABAJOS = 0.19  # Fraccion de fs de cada etapa
+
+# Ponderacion A (IEC 61672-1): polos en Hz y ceros en 0 Hz
+POLOS_A = [20.598997, 20.598997, 107.65265, 737.86223, 12194.217, 12194.217]
+CEROS_A = 4
+
+# Tolerancias de clase 1 de IEC 61672-1 (frecuencia nominal, +dB, -dB)
+TOLERANCIA_A = [
+    (10, 3.5, None), (12.5, 3.0, None), (16, 2.5, 4.5), (20, 2.5, 2.5),
+    (25, 2.5, 2.0), (31.5, 2.0, 2.0), (40, 1.5, 1.5), (50, 1.5, 1.5),
+    (63, 1.5, 1.5), (80, 1.5, 1.5), (100, 1.5, 1.5), (125, 1.5, 1.5),
+    (160, 1.5, 1.5), (200, 1.5, 1.5), (250, 1.4, 1.4), (315, 1.4, 1.4),
+    (400, 1.4, 1.4), (500, 1.4, 1.4), (630, 1.4, 1.4), (800, 1.4, 1.4),
+    (1000, 1.1, 1.1), (1250, 1.4, 1.4), (1600, 1.6, 1.6), (2000, 1.6, 1.6),
+    (2500, 1.6, 1.6), (3150, 1.6, 1.6), (4000, 1.6, 1.6), (5000, 2.1, 2.1),
+    (6300, 2.1, 2.6), (8000, 2.1, 3.1), (10000, 2.6, 3.6),
+    (12500, 3.0, 6.0), (16000, 3.5, 17.0), (20000, 4.0, None),
+]
+
+# Limites de clase 1 de IEC 61260-1 para octavas: (exponente de G,
+# atenuacion relativa minima, maxima); simetricos alrededor de fm
+G = 2.0
+MASCARA_OCTAVA = [
+    (0, -0.4, 0.4), (1 / 8, -0.4, 0.6), (1 / 4, -0.4, 0.8),
+    (3 / 8, -0.4, 1.4), (1 / 2, 1.2, 5.5), (1, 16.6, None),
+    (2, 40.5, None), (3, 56.0, None), (4, 60.0, None),
+]
+
+
+def ponderacion_a_analogica(f):
+    """Respuesta exacta de la ponderacion A en dB (IEC 61672-1)."""
+    f2 = f * f
+    ra = (12194.217 ** 2 * f2 * f2) / (
+        (f2 + 20.598997 ** 2)
+        * math.sqrt((f2 + 107.65265 ** 2) * (f2 + 737.86223 ** 2))
+        * (f2 + 12194.217 ** 2))
+    return 20 * math.log10(ra) + 2.0
+
+
+def respuesta(secciones, f, fs):
+    """Magnitud de una cascada de biquads (b0, b1, b2, a1, a2)."""
+    z1 = cmath.exp(-2j * math.pi * f / fs)
+    h = 1
+    for b0, b1, b2, a1, a2 in secciones:
+        h *= (b0 + b1 * z1 + b2 * z1 * z1) / (1 + a1 * z1 + a2 * z1 * z1)
+    return abs(h)
+
+
+def db(x):
+    return 20 * math.log10(max(x, 1e-30))
+
+
+def seccion_desde_raices(ceros, polos):
+    """Biquad con los dos ceros y los dos polos dados (pares conjugados o reales)."""
+    b1 = -(ceros[0] + ceros[1])
+    b2 = ceros[0] * ceros[1]
+    a1 = -(polos[0] + polos[1])
+    a2 = polos[0] * polos[1]
+    return [1.0, b1.real, b2.real, a1.real, a2.real]
+
+
+def normalizar_cascada(secciones, fs):
+    """Escala los b para que la salida de cada seccion tenga ganancia maxima 1.
+
+    Se usa la respuesta acumulada hasta cada seccion, asi ninguna etapa
+    intermedia desborda con una senoidal de amplitud completa y la cascada
+    completa pierde lo menos posible de resolucion.
+    """
+    frecuencias = [fs * k / 8000 for k in range(1, 4000)]
+    escaladas = []
+    for s in secciones:
+        pico = max(respuesta(escaladas + [s], f, fs) for f in frecuencias)
+        escaladas.append([c / pico for c in s[:3]] + s[3:])
+    return escaladas
+
+
+def cuantizar(secciones):
+    escala = 1 << BITS_COEF
+    enteros = []
+    for s in secciones:
+        q = [int(round(c * escala)) for c in s]
+        # Los ceros en z = 1 y z = -1 se conservan exactos: sin ellos el
+        # redondeo deja pasar algo de continua (o de fs/2)
+        cero_continua = abs(s[0] + s[1] + s[2]) < 1e-9
+        cero_nyquist = abs(s[0] - s[1] + s[2]) < 1e-9
+        if cero_continua and cero_nyquist:
+            q[1], q[2] = 0, -q[0]
+        elif cero_continua:
+            q[1] = -(q[0] + q[2])
+        elif cero_nyquist:
+            q[1] = q[0] + q[2]
+        for c in q:
+            if not -32768 <= c <= 32767:
+                raise SystemExit("Coeficiente fuera de rango Q14: %r" % (s,))
+        enteros.append(q)
+    reales = [[c / escala for c in q] for q in enteros]
+    return enteros, reales
+
+
+def disenar_a(c):
+    """Ponderacion A con un cero en z = -c para corregir la alta frecuencia.
+
+    Los polos cercanos a z = 1 (20.6 Hz) no se pueden poner de a dos en un
+    biquad Q14: 1 + a1 + a2 = (1 - r)^2 queda por debajo del paso de
+    cuantizacion. Por eso cada uno va con un polo lejano (12.2 kHz).
+    """
+    zp = [cmath.exp(-2 * math.pi * p / FS) for p in POLOS_A]
+    secciones = [
+        seccion_desde_raices([1, 1], [zp[2], zp[3]]),
+        seccion_desde_raices([1, 0], [zp[1], zp[5]]),
+        seccion_desde_raices([1, -c], [zp[0], zp[4]]),
+    ]
+    return normalizar_cascada(secciones, FS)
+
+
+def elegir_a():
+    """Busca el cero de alta frecuencia con menor desviacion dentro de la mascara."""
+    mejor = None
+    for k in range(0, 101, 2):
+        enteros, reales = cuantizar(disenar_a(k / 100))
+        _, peor, errores = verificar_a(reales)
+        if not errores and (mejor is None or peor < mejor[0]):
+            mejor = (peor, enteros, reales)
+    if mejor is None:
+        enteros, reales = cuantizar(disenar_a(0))
+        return enteros, reales
+    return mejor[1], mejor[2]
+
+
+def bilineal(s, fs):
+    return (1 + s / (2 * fs)) / (1 - s / (2 * fs))
+
+
+def prewarp(f, fs):
+    return 2 * fs * math.tan(math.pi * f / fs)
+
+
+def polos_butterworth(orden):
+    return [cmath.exp(1j * math.pi * (2 * k + orden + 1) / (2 * orden)) for k in range(orden)]
+
+
+def disenar_pasabanda(fs):
+    fm = fs / 6
+    wl = prewarp(fm / math.sqrt(G), fs)
+    wh = prewarp(fm * math.sqrt(G), fs)
+    w0 = math.sqrt(wl * wh)
+    ancho = wh - wl
+    polos = []
+    for p in polos_butterworth(ORDEN_PASABANDA):
+        # s -> (s^2 + w0^2) / (ancho s): cada polo pasabajos da dos
+        raiz = cmath.sqrt((p * ancho) ** 2 - 4 * w0 * w0)
+        for s in ((p * ancho + raiz) / 2, (p * ancho - raiz) / 2):
+            z = bilineal(s, fs)
+            if z.imag > 0:
+                polos.append(z)
+    secciones = [seccion_desde_raices([1, -1], [z, z.conjugate()]) for z in polos]
+    return normalizar_cascada(secciones, fs)
+
+
+def disenar_pasabajos(fs):
+    wc = prewarp(CORTE_PASABAJOS * fs, fs)
+    polos = [bilineal(p * wc, fs) for p in polos_butterworth(ORDEN_PASABAJOS)]
+    polos = [z for z in polos if z.imag > 0]
+    secciones = [seccion_desde_raices([-1, -1], [z, z.conjugate()]) for z in polos]
+    return normalizar_cascada(secciones, fs)
+
+
+def plegar(f, fs):
+    """Frecuencia a la que aparece f despues de muestrear a fs."""
+    f = math.fmod(f, fs)
+    return fs - f if f > fs / 2 else f
+
+
+def respuesta_banda(pasabanda, pasabajos, etapa, f):
+    """Ganancia de la banda de la etapa dada a una entrada f (a FS), con aliasing."""
+    fs = FS
+    h = 1.0
+    for _ in range(etapa):
+        h *= respuesta(pasabajos, plegar(f, fs), fs)
+        fs /= 2
+    return h * respuesta(pasabanda, plegar(f, fs), fs)
+
+
+def verificar_a(secciones):
+    ganancia_1k = db(respuesta(secciones, 1000, FS))
+    errores = []
+    peor = 0.0
+    for nominal, mas, menos in TOLERANCIA_A:
+        # Frecuencia exacta de la banda de tercio con base 10
+        f = 1000 * 10 ** (round(10 * math.log10(nominal / 1000)) / 10)
+        if f >= FS / 2:
+            continue
+        desviacion = db(respuesta(secciones, f, FS)) - ganancia_1k - ponderacion_a_analogica(f)
+        if f <= 16000:
+            peor = max(peor, abs(desviacion))
+        if desviacion > mas or (menos is not None and desviacion < -menos):
+            errores.append("A: %.1f Hz desviacion %.2f dB" % (nominal, desviacion))
+    return ganancia_1k, peor, errores
+
+
+def verificar_octavas(pasabanda, pasabajos):
+    errores = []
+    ganancias = []
+    for etapa in range(N_BANDAS):
+        fm = FS / 6 / 2 ** etapa
+        ref = db(respuesta_banda(pasabanda, pasabajos, etapa, fm))
+        ganancias.append(ref)
+        for exponente, minimo, maximo in MASCARA_OCTAVA:
+            for signo in (1, -1):
+                f = fm * G ** (signo * exponente)
+                if f >= FS / 2:
+                    continue
+                atenuacion = ref - db(respuesta_banda(pasabanda, pasabajos, etapa, f))
+                if atenuacion < minimo or (maximo is not None and atenuacion > maximo):
+                    errores.append("octava %.1f Hz: G^%+.3f atenuacion %.2f dB"
+                                   % (fm, signo * exponente, atenuacion))
+        # Fuera de G^(+-4), incluyendo lo que se pliega en los diezmados
+        limite = MASCARA_OCTAVA[-1][1]
+        for k in range(1, 4800):
+            f = k * 5.0
+            if fm / G ** 4 < f < fm * G ** 4:
+                continue
+            atenuacion = ref - db(respuesta_banda(pasabanda, pasabajos, etapa, f))
+            if atenuacion < limite:
+                errores.append("octava %.1f Hz: %.0f Hz atenuacion %.1f dB" % (fm, f, atenuacion))
+                break
+    return ganancias, errores
+
+
+def escribir_secciones(nombre, enteros, comentario):
+    lineas = ["// %s" % comentario,
+              "static const biquad_coef_t %s[%d] = {" % (nombre, len(enteros))]
+    for b0, b1, b2, a1, a2 in enteros:
+        lineas.append("    {%d, %d, %d, %d, %d}," % (b0, b1, b2, a1, a2))
+    lineas.append("};")
+    return lineas
+
+
+def main():
+    salida = sys.argv[1] if len(sys.argv) > 1 else "include/filtros_coef.h"
+
+    a_enteros, a_reales = elegir_a()
+    pb_enteros, pb_reales = cuantizar(disenar_pasabanda(FS))
+    lp_enteros, lp_reales = cuantizar(disenar_pasabajos(FS))
+
+    ganancia_a, peor_a, errores = verificar_a(a_reales)
+    ganancias, errores_octava = verificar_octavas(pb_reales, lp_reales)
+    errores += errores_octava
+    for e in errores:
+        print(e, file=sys.stderr)
+    if errores:
+        raise SystemExit("Filtros fuera de mascara; no se escribio %s" % salida)
+    print("Ponderacion A: desviacion maxima %.3f dB hasta 16 kHz" % peor_a)
+    print("Octavas: dentro de la mascara de clase 1")
+
+    lineas = [
+        "// Generado por tools/generar_filtros.py; no editar a mano",
+        "#ifndef FILTROS_COEF_H",
+        "#define FILTROS_COEF_H",
+        "",
+        '#include "filtros.h"',
+        "",
+        "#if FILTROS_FS != %d || N_BANDAS_OCTAVA != %d" % (FS, N_BANDAS),
+        "#error \"filtros_coef.h se genero para otra frecuencia o numero de bandas\"",
+        "#endif",
+        "",
+    ]
+    lineas += escribir_secciones("ponderacion_a", a_enteros,
+                                 "Ponderacion A, Q%d (b0, b1, b2, a1, a2)" % BITS_COEF)
+    lineas += ["", "// Correccion para que la ponderacion A de 0 dB a 1 kHz, en Q8",
+               "#define PONDERACION_A_DB_Q8 %d" % round(-ganancia_a * 256), ""]
+    lineas += escribir_secciones("octava_pasabanda", pb_enteros,
+                                 "Pasabanda de octava centrado en fs/6 de cada etapa, Q%d" % BITS_COEF)
+    lineas += [""]
+    lineas += escribir_secciones("octava_pasabajos", lp_enteros,
+                                 "Pasabajos antes de cada diezmado por 2 (corte %.2f fs), Q%d"
+                                 % (CORTE_PASABAJOS, BITS_COEF))
+    lineas += ["", "// Correccion de ganancia en la frecuencia central de cada banda (62.5 Hz primero), en Q8",
+               "static const int16_t octava_db_q8[N_BANDAS_OCTAVA] = {"]
+    lineas.append("    " + ", ".join("%d" % round(-g * 256) for g in reversed(ganancias)))
+    lineas += ["};", "", "#endif"]
+
+    with open(salida, "w", newline="\r\n") as archivo:
+        archivo.write("\n".join(lineas) + "\n")
+    print("Escrito %s" % salida)
+
+
+if __name__ == "__main__":
+    main()